@@ -0,0 +1,125 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Lightweight instrumentation that records time and memory usage of compiler phases.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <algorithm>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+
+thread_local Profiler* t_activeProfiler = nullptr;
+thread_local string t_activeContract;
+
+}
+
+void Profiler::Statistics::add(Statistics const& _other)
+{
+	time += _other.time;
+	calls += _other.calls;
+	peakRSS = max(peakRSS, _other.peakRSS);
+}
+
+void Profiler::record(string const& _phase, string const& _contract, chrono::nanoseconds _time)
+{
+	Statistics invocation;
+	invocation.time = _time;
+	invocation.calls = 1;
+	invocation.peakRSS = peakRSS();
+
+	lock_guard<mutex> lock(m_mutex);
+	auto phase = find_if(m_phases.begin(), m_phases.end(), [&](Phase const& _p) { return _p.name == _phase; });
+	if (phase == m_phases.end())
+	{
+		m_phases.push_back(Phase{_phase, {}, {}});
+		phase = prev(m_phases.end());
+	}
+	phase->total.add(invocation);
+	if (!_contract.empty())
+		phase->contracts[_contract].add(invocation);
+}
+
+vector<Profiler::Phase> Profiler::phases() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_phases;
+}
+
+void Profiler::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_phases.clear();
+}
+
+Profiler* Profiler::active()
+{
+	return t_activeProfiler;
+}
+
+size_t Profiler::peakRSS()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return size_t(usage.ru_maxrss);
+#else
+	return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+ProfilerScope::ProfilerScope(Profiler* _profiler, string _contract):
+	m_previousProfiler(t_activeProfiler),
+	m_previousContract(std::move(t_activeContract))
+{
+	t_activeProfiler = _profiler;
+	t_activeContract = std::move(_contract);
+}
+
+ProfilerScope::~ProfilerScope()
+{
+	t_activeProfiler = m_previousProfiler;
+	t_activeContract = std::move(m_previousContract);
+}
+
+ScopedPhase::ScopedPhase(char const* _name):
+	m_profiler(t_activeProfiler),
+	m_name(_name)
+{
+	if (m_profiler)
+		m_start = chrono::steady_clock::now();
+}
+
+ScopedPhase::~ScopedPhase()
+{
+	if (m_profiler)
+		m_profiler->record(m_name, t_activeContract, chrono::steady_clock::now() - m_start);
+}
@@ -0,0 +1,122 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Lightweight instrumentation that records time and memory usage of compiler phases.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Collects the wall-clock time, the number of invocations and the peak resident set size
+ * of named phases, both in total and per contract.
+ * Phases are recorded by ScopedPhase objects, which do nothing unless a profiler was made
+ * active on the current thread through a ProfilerScope. Recording is thread-safe.
+ */
+class Profiler
+{
+public:
+	struct Statistics
+	{
+		std::chrono::nanoseconds time{0};
+		size_t calls = 0;
+		/// Peak resident set size of the process at the end of the phase in bytes,
+		/// zero if unknown.
+		size_t peakRSS = 0;
+
+		void add(Statistics const& _other);
+	};
+
+	struct Phase
+	{
+		std::string name;
+		Statistics total;
+		/// Statistics per fully qualified contract name, only for the invocations
+		/// that were attributed to a contract.
+		std::map<std::string, Statistics> contracts;
+	};
+
+	/// Adds one invocation of @a _phase to the statistics.
+	/// @param _contract the contract the invocation is attributed to, may be empty.
+	void record(std::string const& _phase, std::string const& _contract, std::chrono::nanoseconds _time);
+
+	/// @returns the statistics of all phases in the order they were first recorded in.
+	std::vector<Phase> phases() const;
+
+	void clear();
+
+	/// @returns the profiler that is active on the current thread or nullptr.
+	static Profiler* active();
+
+	/// @returns the peak resident set size of the current process in bytes or zero
+	/// if it cannot be determined.
+	static size_t peakRSS();
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector<Phase> m_phases;
+};
+
+/**
+ * Makes a profiler active on the current thread and attributes the phases to a contract
+ * for the lifetime of the object. The previous state is restored on destruction, so
+ * scopes can be nested.
+ */
+class ProfilerScope
+{
+public:
+	/// @param _profiler the profiler to activate, nullptr disables profiling in this scope.
+	explicit ProfilerScope(Profiler* _profiler, std::string _contract = std::string());
+	~ProfilerScope();
+
+	ProfilerScope(ProfilerScope const&) = delete;
+	ProfilerScope& operator=(ProfilerScope const&) = delete;
+
+private:
+	Profiler* m_previousProfiler;
+	std::string m_previousContract;
+};
+
+/**
+ * Records the lifetime of the object as one invocation of a phase in the active profiler.
+ * Times of nested phases are included in the time of the enclosing phase.
+ */
+class ScopedPhase
+{
+public:
+	/// @param _name name of the phase, has to outlive the object.
+	explicit ScopedPhase(char const* _name);
+	~ScopedPhase();
+
+	ScopedPhase(ScopedPhase const&) = delete;
+	ScopedPhase& operator=(ScopedPhase const&) = delete;
+
+private:
+	Profiler* m_profiler;
+	char const* m_name;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+}
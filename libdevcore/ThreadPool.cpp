@@ -0,0 +1,106 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fixed set of threads that processes batches of independent tasks.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+using namespace std;
+using namespace dev;
+
+ThreadPool::ThreadPool(unsigned _threads)
+{
+	for (unsigned i = 1; i < _threads; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_tasksAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::run(size_t _count, function<void(size_t)> const& _task)
+{
+	unique_lock<mutex> lock(m_mutex);
+	if (m_workers.empty() || _count <= 1 || m_task)
+	{
+		lock.unlock();
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	m_task = &_task;
+	m_count = _count;
+	m_nextIndex = 0;
+	m_unfinished = _count;
+	m_failures.assign(_count, nullptr);
+	m_tasksAvailable.notify_all();
+
+	processTasks(lock);
+	m_batchFinished.wait(lock, [&]() { return m_unfinished == 0; });
+	m_task = nullptr;
+	vector<exception_ptr> failures = std::move(m_failures);
+	lock.unlock();
+
+	for (exception_ptr const& failure: failures)
+		if (failure)
+			rethrow_exception(failure);
+}
+
+void ThreadPool::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_tasksAvailable.wait(lock, [&]() { return m_stopping || (m_task && m_nextIndex < m_count); });
+		if (m_stopping)
+			return;
+		processTasks(lock);
+	}
+}
+
+void ThreadPool::processTasks(unique_lock<mutex>& _lock)
+{
+	while (m_task && m_nextIndex < m_count)
+	{
+		function<void(size_t)> const& task = *m_task;
+		size_t const index = m_nextIndex++;
+		_lock.unlock();
+		exception_ptr failure;
+		try
+		{
+			task(index);
+		}
+		catch (...)
+		{
+			failure = current_exception();
+		}
+		_lock.lock();
+		if (failure)
+			m_failures[index] = failure;
+		if (--m_unfinished == 0)
+			m_batchFinished.notify_all();
+	}
+}
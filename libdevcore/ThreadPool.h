@@ -0,0 +1,76 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fixed set of threads that processes batches of independent tasks.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Fixed set of threads that processes batches of independent tasks. The threads are
+ * started once and reused for every batch. The thread that submits a batch takes part
+ * in processing it, so a pool of a single thread does not start any threads at all.
+ * Only one batch is processed concurrently at a time. A batch that is submitted while
+ * another one is processed, e.g. by one of its tasks or by a different user of a shared
+ * pool, is run sequentially by the submitting thread.
+ */
+class ThreadPool: private boost::noncopyable
+{
+public:
+	/// @param _threads the number of threads that process a batch, including the one
+	/// that submits it.
+	explicit ThreadPool(unsigned _threads);
+	~ThreadPool();
+
+	unsigned threads() const { return unsigned(m_workers.size()) + 1; }
+
+	/// Runs @a _task for every index below @a _count and returns after all of them finished.
+	/// If tasks throw, the exception of the lowest index is rethrown after all tasks finished.
+	void run(size_t _count, std::function<void(size_t)> const& _task);
+
+private:
+	void work();
+	/// Processes tasks of the current batch until none is left, @a _lock has to hold m_mutex.
+	void processTasks(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	std::condition_variable m_tasksAvailable;
+	std::condition_variable m_batchFinished;
+	std::vector<std::thread> m_workers;
+	bool m_stopping = false;
+
+	/// The current batch, only valid while m_task is not null.
+	std::function<void(size_t)> const* m_task = nullptr;
+	size_t m_count = 0;
+	size_t m_nextIndex = 0;
+	size_t m_unfinished = 0;
+	std::vector<std::exception_ptr> m_failures;
+};
+
+}
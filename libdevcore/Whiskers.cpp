@@ -25,13 +25,197 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <boost/regex.hpp>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+/**
+ * A template parsed into literal text, parameters, lists and conditions. The bodies of
+ * lists and conditions are parsed recursively. Parsing follows the regular expression
+ * "<([^#/?!>]+)>|<#([^>]+)>(.*?)</\2>|<\?([^>]+)>(.*?)(<!\4>(.*?))?</\4>" that was used
+ * to replace the tags before: everything that is not a complete tag is literal text.
+ */
+struct Whiskers::Template
+{
+	enum class Kind { Text, Parameter, List, Condition };
+	struct Segment
+	{
+		Kind kind;
+		/// The text for Kind::Text, the name of the parameter otherwise.
+		string value;
+		/// The body of a list or the part of a condition for the true case.
+		unique_ptr<Template const> body;
+		/// The part of a condition for the false case.
+		unique_ptr<Template const> elseBody;
+	};
+
+	/// Values the template is rendered with.
+	struct Values
+	{
+		StringMap const& parameters;
+		/// The values of the current list element, nullptr outside of lists.
+		StringMap const* listElement;
+		map<string, bool> const& conditions;
+		/// nullptr inside of lists, since lists cannot contain lists.
+		StringListMap const* listParameters;
+	};
+
+	explicit Template(string _text);
+
+	/// Calls @a _emit for every piece of the output in order.
+	template <class Emit>
+	void render(Values const& _values, Emit const& _emit) const;
+
+	/// The source of the template, used for error messages.
+	string text;
+	vector<Segment> segments;
+};
+
+Whiskers::Template::Template(string _text):
+	text(move(_text))
+{
+	auto isSpecial = [](char _c) { return _c == '#' || _c == '/' || _c == '?' || _c == '!' || _c == '>'; };
+	auto part = [&](size_t _begin, size_t _end) {
+		return unique_ptr<Template const>(new Template(text.substr(_begin, _end - _begin)));
+	};
+
+	size_t const length = text.size();
+	size_t textStart = 0;
+	size_t position = 0;
+	while ((position = text.find('<', position)) != string::npos)
+	{
+		Segment segment;
+		size_t end = string::npos;
+		if (position + 1 < length && !isSpecial(text[position + 1]))
+		{
+			size_t nameEnd = position + 1;
+			while (nameEnd < length && !isSpecial(text[nameEnd]))
+				++nameEnd;
+			if (nameEnd < length && text[nameEnd] == '>')
+			{
+				segment.kind = Kind::Parameter;
+				segment.value = text.substr(position + 1, nameEnd - position - 1);
+				end = nameEnd + 1;
+			}
+		}
+		else if (position + 1 < length && (text[position + 1] == '#' || text[position + 1] == '?'))
+		{
+			size_t const nameEnd = text.find('>', position + 2);
+			if (nameEnd != string::npos && nameEnd > position + 2)
+			{
+				string name = text.substr(position + 2, nameEnd - position - 2);
+				string const closingTag = "</" + name + ">";
+				size_t const bodyStart = nameEnd + 1;
+				size_t const closing = text.find(closingTag, bodyStart);
+				if (closing != string::npos)
+				{
+					if (text[position + 1] == '#')
+					{
+						segment.kind = Kind::List;
+						segment.body = part(bodyStart, closing);
+					}
+					else
+					{
+						string const elseTag = "<!" + name + ">";
+						size_t const elsePosition = text.find(elseTag, bodyStart);
+						segment.kind = Kind::Condition;
+						if (elsePosition != string::npos && elsePosition < closing)
+						{
+							segment.body = part(bodyStart, elsePosition);
+							segment.elseBody = part(elsePosition + elseTag.size(), closing);
+						}
+						else
+							segment.body = part(bodyStart, closing);
+					}
+					segment.value = move(name);
+					end = closing + closingTag.size();
+				}
+			}
+		}
+
+		if (end == string::npos)
+		{
+			++position;
+			continue;
+		}
+		if (textStart < position)
+			segments.push_back(Segment{Kind::Text, text.substr(textStart, position - textStart), nullptr, nullptr});
+		segments.push_back(move(segment));
+		position = textStart = end;
+	}
+	if (textStart < length)
+		segments.push_back(Segment{Kind::Text, text.substr(textStart), nullptr, nullptr});
+}
+
+template <class Emit>
+void Whiskers::Template::render(Values const& _values, Emit const& _emit) const
+{
+	for (Segment const& segment: segments)
+		switch (segment.kind)
+		{
+		case Kind::Text:
+			_emit(segment.value);
+			break;
+		case Kind::Parameter:
+		{
+			if (_values.listElement)
+			{
+				auto it = _values.listElement->find(segment.value);
+				if (it != _values.listElement->end())
+				{
+					_emit(it->second);
+					break;
+				}
+			}
+			auto it = _values.parameters.find(segment.value);
+			assertThrow(
+				it != _values.parameters.end(),
+				WhiskersError,
+				"Value for tag " + segment.value + " not provided.\n" +
+				"Template:\n" +
+				text
+			);
+			_emit(it->second);
+			break;
+		}
+		case Kind::List:
+		{
+			assertThrow(
+				_values.listParameters && _values.listParameters->count(segment.value),
+				WhiskersError, "List parameter " + segment.value + " not set."
+			);
+			for (StringMap const& element: _values.listParameters->at(segment.value))
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!_values.parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				segment.body->render(Values{_values.parameters, &element, _values.conditions, nullptr}, _emit);
+			}
+			break;
+		}
+		case Kind::Condition:
+		{
+			auto it = _values.conditions.find(segment.value);
+			assertThrow(
+				it != _values.conditions.end(),
+				WhiskersError, "Condition parameter " + segment.value + " not set."
+			);
+			if (it->second)
+				segment.body->render(_values, _emit);
+			else if (segment.elseBody)
+				segment.elseBody->render(_values, _emit);
+			break;
+		}
+		}
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(compile(move(_template)))
 {
 }
 
@@ -61,7 +245,14 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	Template::Values const values{m_parameters, nullptr, m_conditions, &m_listParameters};
+	// Determine the size first, so that the result is allocated only once.
+	size_t size = 0;
+	m_template->render(values, [&](string const& _part) { size += _part.size(); });
+	string result;
+	result.reserve(size);
+	m_template->render(values, [&](string const& _part) { result += _part; });
+	return result;
 }
 
 void Whiskers::checkParameterUnknown(string const& _parameter)
@@ -83,72 +274,21 @@ void Whiskers::checkParameterUnknown(string const& _parameter)
 	);
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+shared_ptr<Whiskers::Template const> Whiskers::compile(string _template)
 {
-	using namespace boost;
-	static regex listOrTag("<([^#/?!>]+)>|<#([^>]+)>(.*?)</\\2>|<\\?([^>]+)>(.*?)(<!\\4>(.*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
-			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
+	// Templates are mostly string literals, the limit only guards against templates that
+	// are assembled at runtime.
+	static size_t constexpr c_maxCachedTemplates = 4096;
+	static mutex s_mutex;
+	static unordered_map<string, shared_ptr<Template const>> s_cache;
 
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	lock_guard<mutex> lock(s_mutex);
+	auto it = s_cache.find(_template);
+	if (it != s_cache.end())
+		return it->second;
+	if (s_cache.size() >= c_maxCachedTemplates)
+		s_cache.clear();
+	auto parsed = make_shared<Template const>(_template);
+	s_cache.emplace(move(_template), parsed);
+	return parsed;
 }
-
@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -62,6 +63,10 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed into a list of segments only once and the parsed form is cached
+ * by the template string, so constructing a Whiskers object for a template that was
+ * used before is cheap.
  */
 class Whiskers
 {
@@ -85,19 +90,15 @@ public:
 	std::string render() const;
 
 private:
-	void checkParameterUnknown(std::string const& _parameter);
+	/// Parsed form of a (part of a) template.
+	struct Template;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
+	void checkParameterUnknown(std::string const& _parameter);
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed form of @a _template, either from the cache or parsed anew.
+	static std::shared_ptr<Template const> compile(std::string _template);
 
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -53,9 +53,31 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace langutil;
 
+CharStream& CharStream::operator=(CharStream const& _other)
+{
+	m_source = _other.m_source;
+	m_name = _other.m_name;
+	m_position = _other.m_position;
+	lock_guard<mutex> lock(m_lineStartsMutex);
+	m_lineStarts.clear();
+	return *this;
+}
+
+CharStream& CharStream::operator=(CharStream&& _other)
+{
+	m_source = std::move(_other.m_source);
+	m_name = std::move(_other.m_name);
+	m_position = _other.m_position;
+	lock_guard<mutex> lock(m_lineStartsMutex);
+	m_lineStarts.clear();
+	return *this;
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -76,35 +98,35 @@ char CharStream::rollback(size_t _amount)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	size_t const line = lineOf(min<size_t>(m_source.size(), _position));
+	size_t const lineStart = starts[line];
+	size_t const lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	return m_source.substr(lineStart, lineEnd - lineStart);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_t const searchPosition = min<size_t>(m_source.size(), _position);
+	size_t const line = lineOf(searchPosition);
+	return tuple<int, int>(line, searchPosition - lineStarts()[line]);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	lock_guard<mutex> lock(m_lineStartsMutex);
+	if (m_lineStarts.empty())
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		m_lineStarts.push_back(0);
+		for (size_t i = 0; i < m_source.size(); ++i)
+			if (m_source[i] == '\n')
+				m_lineStarts.push_back(i + 1);
 	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	return m_lineStarts;
 }
 
-
+size_t CharStream::lineOf(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	return size_t(upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
+}
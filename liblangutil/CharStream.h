@@ -53,8 +53,10 @@
 #pragma once
 
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace langutil
 {
@@ -70,6 +72,13 @@ public:
 	CharStream() = default;
 	explicit CharStream(std::string const& _source, std::string const& name):
 		m_source(_source), m_name(name) {}
+	/// The index of the line starts is not copied, it is computed again when needed.
+	CharStream(CharStream const& _other):
+		m_source(_other.m_source), m_name(_other.m_name), m_position(_other.m_position) {}
+	CharStream(CharStream&& _other):
+		m_source(std::move(_other.m_source)), m_name(std::move(_other.m_name)), m_position(_other.m_position) {}
+	CharStream& operator=(CharStream const& _other);
+	CharStream& operator=(CharStream&& _other);
 
 	int position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
@@ -85,16 +94,24 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call builds an index of the line starts, further calls take logarithmic time.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
+	/// @returns the positions at which the lines start, computing them on first use.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the zero-based line of the character at @a _position.
+	size_t lineOf(size_t _position) const;
+
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Positions of the line starts, empty until first used.
+	mutable std::vector<size_t> m_lineStarts;
+	mutable std::mutex m_lineStartsMutex;
 };
 
 }
@@ -38,7 +38,7 @@ class ParserBase
 public:
 	explicit ParserBase(ErrorReporter& errorReporter): m_errorReporter(errorReporter) {}
 
-	std::shared_ptr<CharStream> source() const { return m_scanner->charStream(); }
+	CharStreamRef source() const { return m_scanner->sourceReference(); }
 
 protected:
 	/// Utility class that creates an error and throws an exception if the
@@ -96,6 +96,8 @@ public:
 	std::string const& source() const noexcept { return m_source->source(); }
 
 	std::shared_ptr<CharStream> charStream() noexcept { return m_source; }
+	/// @returns the reference to the source that is stored in source locations.
+	CharStreamRef sourceReference() const noexcept { return CharStreamRef(m_source); }
 
 	/// Resets the scanner as if newly constructed with _source as input.
 	void reset(CharStream _source);
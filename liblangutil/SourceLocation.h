@@ -32,6 +32,29 @@
 namespace langutil
 {
 
+/**
+ * Non-owning reference to a CharStream. In contrast to a shared pointer, it can be copied
+ * without touching a reference count. The stream is kept alive by the SourceTable of the
+ * compilation (or by another owner, e.g. the scanner) for as long as the reference is resolved.
+ */
+class CharStreamRef
+{
+public:
+	CharStreamRef() = default;
+	CharStreamRef(std::shared_ptr<CharStream> const& _source): m_source(_source.get()) {}
+
+	/// @returns the referenced stream or nullptr if there is none.
+	CharStream const* get() const { return m_source; }
+	CharStream const* operator->() const { return m_source; }
+	explicit operator bool() const { return m_source != nullptr; }
+
+	bool operator==(CharStreamRef const& _other) const { return m_source == _other.m_source; }
+	bool operator!=(CharStreamRef const& _other) const { return m_source != _other.m_source; }
+
+private:
+	CharStream const* m_source = nullptr;
+};
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
@@ -40,7 +63,7 @@ struct SourceLocation
 {
 	bool operator==(SourceLocation const& _other) const
 	{
-		return source.get() == _other.source.get() && start == _other.start && end == _other.end;
+		return source == _other.source && start == _other.start && end == _other.end;
 	}
 	bool operator!=(SourceLocation const& _other) const { return !operator==(_other); }
 	inline bool operator<(SourceLocation const& _other) const;
@@ -71,7 +94,7 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<CharStream> source;
+	CharStreamRef source;
 };
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -80,8 +103,8 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 	if (_location.isEmpty())
 		return _out << "NO_LOCATION_SPECIFIED";
 
-	if (_location.source)
-		_out << _location.source->name();
+	if (auto source = _location.source.get())
+		_out << source->name();
 
 	_out << "[" << _location.start << "," << _location.end << ")";
 
@@ -90,22 +113,26 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 
 bool SourceLocation::operator<(SourceLocation const& _other) const
 {
-	if (!source|| !_other.source)
-		return std::make_tuple(int(!!source), start, end) < std::make_tuple(int(!!_other.source), _other.start, _other.end);
+	if (source == _other.source)
+		return std::make_tuple(start, end) < std::make_tuple(_other.start, _other.end);
+	auto thisSource = source.get();
+	auto otherSource = _other.source.get();
+	if (!thisSource || !otherSource)
+		return std::make_tuple(int(!!thisSource), start, end) < std::make_tuple(int(!!otherSource), _other.start, _other.end);
 	else
-		return std::make_tuple(source->name(), start, end) < std::make_tuple(_other.source->name(), _other.start, _other.end);
+		return std::make_tuple(thisSource->name(), start, end) < std::make_tuple(otherSource->name(), _other.start, _other.end);
 }
 
 bool SourceLocation::contains(SourceLocation const& _other) const
 {
-	if (isEmpty() || _other.isEmpty() || source.get() != _other.source.get())
+	if (isEmpty() || _other.isEmpty() || source != _other.source)
 		return false;
 	return start <= _other.start && _other.end <= end;
 }
 
 bool SourceLocation::intersects(SourceLocation const& _other) const
 {
-	if (isEmpty() || _other.isEmpty() || source.get() != _other.source.get())
+	if (isEmpty() || _other.isEmpty() || source != _other.source)
 		return false;
 	return _other.start < end && start < _other.end;
 }
@@ -46,7 +46,7 @@ SourceReference SourceReferenceExtractor::extract(SourceLocation const* _locatio
 	if (!_location || !_location->source.get()) // Nothing we can extract here
 		return SourceReference::MessageOnly(std::move(message));
 
-	shared_ptr<CharStream> const& source = _location->source;
+	CharStream const* source = _location->source.get();
 
 	LineColumn const interest = source->translatePositionToLineColumn(_location->start);
 	LineColumn start = interest;
@@ -0,0 +1,41 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Owner of the sources referenced by the source locations of a compilation.
+ */
+
+#include <liblangutil/SourceTable.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace langutil;
+
+CharStreamRef SourceTable::add(shared_ptr<CharStream> _source)
+{
+	polAssert(_source, "");
+	CharStreamRef reference(_source);
+	lock_guard<mutex> lock(m_mutex);
+	m_sources.insert(std::move(_source));
+	return reference;
+}
+
+size_t SourceTable::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_sources.size();
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Owner of the sources referenced by the source locations of a compilation.
+ */
+
+#pragma once
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace langutil
+{
+
+/**
+ * Owner of the sources referenced by the source locations of a compilation.
+ *
+ * Source locations refer to their source through a plain pointer (see CharStreamRef), so
+ * the stream has to be kept alive as long as locations referring to it are used. Every
+ * compilation (compiler stack, assembly stack) owns a table and adds each source it
+ * creates locations from, including generated code.
+ * Entries are never modified or removed, so locations are resolved without any locking.
+ * Only adding a source is synchronised, so sources can be added from concurrent tasks.
+ */
+class SourceTable: private boost::noncopyable
+{
+public:
+	/// Keeps @a _source alive as long as the table and @returns the reference to it.
+	CharStreamRef add(std::shared_ptr<CharStream> _source);
+
+	/// @returns the number of sources in the table.
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::set<std::shared_ptr<CharStream>> m_sources;
+};
+
+}
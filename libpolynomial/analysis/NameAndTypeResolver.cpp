@@ -46,10 +46,10 @@ NameAndTypeResolver::NameAndTypeResolver(
 	m_globalContext(_globalContext)
 {
 	if (!m_scopes[nullptr])
-		m_scopes[nullptr].reset(new DeclarationContainer());
-	for (Declaration const* declaration: _globalContext.declarations())
 	{
-		polAssert(m_scopes[nullptr]->registerDeclaration(*declaration), "Unable to register global declaration.");
+		m_scopes[nullptr].reset(new DeclarationContainer());
+		for (Declaration const* declaration: _globalContext.declarations())
+			polAssert(m_scopes[nullptr]->registerDeclaration(*declaration), "Unable to register global declaration.");
 	}
 }
 
@@ -39,14 +39,15 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static size_t last() { return instance(); }
+	static void reset(size_t _lastID) { instance() = _lastID; }
 private:
+	/// IDs are dispensed per thread, so that sources can be parsed concurrently.
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
-		return dispenser.id;
+		static thread_local size_t id = 0;
+		return id;
 	}
-	size_t id = 0;
 };
 
 ASTNode::ASTNode(SourceLocation const& _location):
@@ -60,9 +61,43 @@ ASTNode::~ASTNode()
 	delete m_annotation;
 }
 
-void ASTNode::resetID()
+void ASTNode::resetID(size_t _lastID)
 {
-	IDDispenser::reset();
+	IDDispenser::reset(_lastID);
+}
+
+size_t ASTNode::lastID()
+{
+	return IDDispenser::last();
+}
+
+void ASTNode::shiftIDs(SourceUnit& _sourceUnit, size_t _offset)
+{
+	class IDShifter: public ASTVisitor
+	{
+	public:
+		explicit IDShifter(size_t _offset): m_offset(_offset) {}
+		bool visit(ImportDirective& _import) override
+		{
+			// The identifiers of symbol aliases are not visited as children.
+			for (auto const& alias: _import.symbolAliases())
+				alias.first->m_id += m_offset;
+			return visitNode(_import);
+		}
+	protected:
+		bool visitNode(ASTNode& _node) override
+		{
+			_node.m_id += m_offset;
+			return true;
+		}
+	private:
+		size_t m_offset;
+	};
+
+	if (_offset == 0)
+		return;
+	IDShifter shifter(_offset);
+	_sourceUnit.accept(shifter);
 }
 
 ASTAnnotation& ASTNode::annotation() const
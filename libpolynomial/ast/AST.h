@@ -70,8 +70,14 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the ID counter so that the next node created on the current thread gets the ID
+	/// @a _lastID + 1. Resetting to zero invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the last node created on the current thread (after the last reset).
+	static size_t lastID();
+	/// Adds @a _offset to the IDs of @a _sourceUnit and all nodes below it. Used to move source
+	/// units that were parsed on other threads into the ID sequence of the current thread.
+	static void shiftIDs(SourceUnit& _sourceUnit, size_t _offset);
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -106,7 +112,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
@@ -0,0 +1,50 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Region based memory for the nodes of a source unit.
+ */
+
+#include <libpolynomial/ast/ASTArena.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	polAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Alignment has to be a power of two.");
+	size_t padding = (_alignment - reinterpret_cast<uintptr_t>(m_position) % _alignment) % _alignment;
+	if (!m_position || padding + _size > m_remaining)
+	{
+		// Objects larger than a chunk get a chunk of their own.
+		size_t const chunkSize = max(c_chunkSize, _size + _alignment);
+		m_chunks.emplace_back(new char[chunkSize]);
+		m_position = m_chunks.back().get();
+		m_remaining = chunkSize;
+		padding = (_alignment - reinterpret_cast<uintptr_t>(m_position) % _alignment) % _alignment;
+	}
+	void* result = m_position + padding;
+	m_position += padding + _size;
+	m_remaining -= padding + _size;
+	m_allocatedBytes += _size;
+	return result;
+}
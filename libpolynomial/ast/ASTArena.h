@@ -0,0 +1,89 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Region based memory for the nodes of a source unit.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace polynomial
+{
+
+/**
+ * Bump allocator that hands out memory from large chunks. Individual allocations are
+ * never returned, all memory is released at once when the arena is destroyed.
+ * Not thread-safe: an arena must only be allocated from by a single thread.
+ */
+class ASTArena: private boost::noncopyable
+{
+public:
+	/// @returns memory for @a _size bytes aligned to @a _alignment, which has to be a power of two.
+	void* allocate(size_t _size, size_t _alignment);
+
+	/// @returns the number of bytes handed out so far.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+	/// @returns the number of chunks requested from the global allocator so far.
+	size_t chunkCount() const { return m_chunks.size(); }
+
+private:
+	static size_t constexpr c_chunkSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<char[]>> m_chunks;
+	char* m_position = nullptr;
+	size_t m_remaining = 0;
+	size_t m_allocatedBytes = 0;
+};
+
+/**
+ * Standard allocator on top of an ASTArena, meant to be used with std::allocate_shared.
+ * Every object (through its control block) keeps the arena alive, so AST nodes can still be
+ * shared with and outlive the source unit they belong to.
+ */
+template <class T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<ASTArena> m_arena;
+};
+
+}
+}
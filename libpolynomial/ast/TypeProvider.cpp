@@ -173,6 +173,7 @@ inline void clearCaches(Container& container)
 
 void TypeProvider::reset()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
 	clearCache(m_bytesStorage);
@@ -196,8 +197,12 @@ void TypeProvider::reset()
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
-	return static_cast<T const*>(instance().m_generalTypes.back().get());
+	// The type is constructed outside of the lock because constructors may request other types.
+	auto type = make_unique<T>(std::forward<Args>(_args)...);
+	T const* result = type.get();
+	lock_guard<mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
+	return result;
 }
 
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
@@ -295,6 +300,7 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_bytesStorage)
 		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
 	return m_bytesStorage.get();
@@ -302,6 +308,7 @@ ArrayType const* TypeProvider::bytesStorage()
 
 ArrayType const* TypeProvider::bytesMemory()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_bytesMemory)
 		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
 	return m_bytesMemory.get();
@@ -309,6 +316,7 @@ ArrayType const* TypeProvider::bytesMemory()
 
 ArrayType const* TypeProvider::stringStorage()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_stringStorage)
 		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
 	return m_stringStorage.get();
@@ -316,6 +324,7 @@ ArrayType const* TypeProvider::stringStorage()
 
 ArrayType const* TypeProvider::stringMemory()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_stringMemory)
 		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
 	return m_stringMemory.get();
@@ -358,6 +367,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -369,6 +379,7 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 {
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
+	lock_guard<mutex> lock(instance().m_mutex);
 	auto i = map.find(make_pair(m, n));
 	if (i != map.end())
 		return i->second.get();
@@ -392,8 +403,11 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	unique_ptr<ReferenceType> type = _type->copyForLocation(_location, _isPointer);
+	ReferenceType const* result = type.get();
+	lock_guard<mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
+	return result;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, bool _isInternal)
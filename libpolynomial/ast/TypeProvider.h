@@ -22,6 +22,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 namespace dev
@@ -37,6 +38,9 @@ namespace polynomial
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Requesting types is thread-safe. Note that this does not extend to the lazily computed
+ * caches inside the types themselves (e.g. member lists).
  */
 class TypeProvider
 {
@@ -218,6 +222,8 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// Guards the containers above and the lazily-initialized static types.
+	std::mutex m_mutex;
 };
 
 } // namespace polynomial
@@ -29,7 +29,7 @@ using namespace std;
 using namespace dev;
 using namespace dev::polynomial;
 
-void Compiler::compileContract(
+void Compiler::generateCode(
 	ContractDefinition const& _contract,
 	std::map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
 	bytes const& _metadata
@@ -47,8 +47,6 @@ void Compiler::compileContract(
 	creationSettings.expectedExecutionsPerDeployment = 1;
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
-
-	m_context.optimise(m_optimiserSettings);
 }
 
 std::shared_ptr<sof::Assembly> Compiler::runtimeAssemblyPtr() const
@@ -35,11 +35,30 @@ namespace polynomial {
 class Compiler
 {
 public:
-	explicit Compiler(langutil::SVMVersion _svmVersion, OptimiserSettings _optimiserSettings):
+	/// @param _inlineAssemblyCache cache for the generated inline assembly, may be nullptr.
+	/// @param _yulFunctionRepository repository for the generated ABI functions, may be nullptr.
+	/// @param _sourceTable owner of the sources of the generated code, may be nullptr.
+	explicit Compiler(
+		langutil::SVMVersion _svmVersion,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr,
+		std::shared_ptr<YulFunctionRepository> _yulFunctionRepository = nullptr,
+		std::shared_ptr<langutil::SourceTable> _sourceTable = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_runtimeContext(_svmVersion),
 		m_context(_svmVersion, &m_runtimeContext)
-	{ }
+	{
+		if (_sourceTable)
+		{
+			m_runtimeContext.setSourceTable(_sourceTable);
+			m_context.setSourceTable(std::move(_sourceTable));
+		}
+		m_runtimeContext.setInlineAssemblyCache(_inlineAssemblyCache);
+		m_context.setInlineAssemblyCache(std::move(_inlineAssemblyCache));
+		m_runtimeContext.setYulFunctionRepository(_yulFunctionRepository);
+		m_context.setYulFunctionRepository(std::move(_yulFunctionRepository));
+	}
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
@@ -47,7 +66,23 @@ public:
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
+	)
+	{
+		generateCode(_contract, _otherCompilers, _metadata);
+		optimise();
+	}
+	/// Generates the unoptimised assembly of a contract. Together with @a optimise,
+	/// this performs the same steps as @a compileContract.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
 	);
+	/// Runs the assembly optimiser on the generated code (including all sub-assemblies).
+	/// Does not access the AST and can thus run concurrently to the code generation of other
+	/// contracts, as long as the sub-assemblies are not shared.
+	void optimise() { m_context.optimise(m_optimiserSettings); }
 	/// @returns Entire assembly.
 	sof::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
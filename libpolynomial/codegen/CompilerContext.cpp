@@ -380,9 +380,64 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	bool const isCreation = m_runtimeContext != nullptr;
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const optimise = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+
+	InlineAssemblyCache::Key cacheKey;
+	shared_ptr<InlineAssemblyCache::Entry const> cached;
+	if (m_inlineAssemblyCache)
+	{
+		cacheKey.code = _assembly;
+		cacheKey.svmVersion = m_svmVersion.name();
+		cacheKey.localVariables = _localVariables;
+		cacheKey.optimise = optimise;
+		if (optimise)
+		{
+			cacheKey.creation = isCreation;
+			cacheKey.optimizeStackAllocation = _optimiserSettings.optimizeStackAllocation;
+			cacheKey.expectedExecutionsPerDeployment = _optimiserSettings.expectedExecutionsPerDeployment;
+			cacheKey.optimiserSteps = _optimiserSettings.yulOptimiserSteps;
+			cacheKey.externallyUsedFunctions = _externallyUsedFunctions;
+		}
+		cached = m_inlineAssemblyCache->find(cacheKey);
+	}
+	if (!cached)
+	{
+		cached = parseAndOptimiseInlineAssembly(_assembly, identifierAccess, externallyUsedIdentifiers, optimise, _optimiserSettings);
+		if (m_inlineAssemblyCache)
+			m_inlineAssemblyCache->insert(std::move(cacheKey), cached);
+	}
+
+	// The code generator does not modify the analysis, but expects a mutable one.
+	yul::AsmAnalysisInfo analysisInfo = *cached->analysisInfo;
+	yul::CodeGenerator::assemble(
+		*cached->code,
+		analysisInfo,
+		*m_asm,
+		m_svmVersion,
+		identifierAccess,
+		_system,
+		_optimiserSettings.optimizeStackAllocation
+	);
+
+	// Reset the source location to the one of the node (instead of the CODEGEN source location)
+	updateSourceLocation();
+}
+
+shared_ptr<InlineAssemblyCache::Entry const> CompilerContext::parseAndOptimiseInlineAssembly(
+	string const& _assembly,
+	yul::ExternalIdentifierAccess const& _identifierAccess,
+	set<yul::YulString> const& _externallyUsedIdentifiers,
+	bool _optimise,
+	OptimiserSettings const& _optimiserSettings
+) const
+{
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+	(m_inlineAssemblyCache ? m_inlineAssemblyCache->sources() : *m_sourceTable).add(scanner->charStream());
 	yul::SVMDialect const& dialect = yul::SVMDialect::strictAssemblyForSVM(m_svmVersion);
 	auto parserResult = yul::Parser(errorReporter, dialect).parse(scanner, false);
 #ifdef POL_OUTPUT_ASM
@@ -412,14 +467,12 @@ void CompilerContext::appendInlineAssembly(
 			errorReporter,
 			boost::none,
 			dialect,
-			identifierAccess.resolve
+			_identifierAccess.resolve
 		).analyze(*parserResult);
 	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
 		reportError("Invalid assembly generated by code generator.");
 
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	if (_optimise)
 	{
 		bool const isCreation = m_runtimeContext != nullptr;
 		yul::OptimiserSuite::run(
@@ -428,7 +481,10 @@ void CompilerContext::appendInlineAssembly(
 			*parserResult,
 			analysisInfo,
 			_optimiserSettings.optimizeStackAllocation,
-			externallyUsedIdentifiers
+			_externallyUsedIdentifiers,
+			_optimiserSettings.yulOptimiserSteps,
+			_optimiserSettings.yulOptimiserThreadPool.get(),
+			_optimiserSettings.yulOptimiserStatistics.get()
 		);
 		analysisInfo = yul::AsmAnalysisInfo{};
 		if (!yul::AsmAnalyzer(
@@ -436,7 +492,7 @@ void CompilerContext::appendInlineAssembly(
 			errorReporter,
 			boost::none,
 			dialect,
-			identifierAccess.resolve
+			_identifierAccess.resolve
 		).analyze(*parserResult))
 			reportError("Optimizer introduced error into inline assembly.");
 #ifdef POL_OUTPUT_ASM
@@ -449,18 +505,11 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	polAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
-		*m_asm,
-		m_svmVersion,
-		identifierAccess,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
 
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	auto entry = make_shared<InlineAssemblyCache::Entry>();
+	entry->code = std::move(parserResult);
+	entry->analysisInfo = make_shared<yul::AsmAnalysisInfo>(std::move(analysisInfo));
+	return entry;
 }
 
 FunctionDefinition const& CompilerContext::resolveVirtualFunction(
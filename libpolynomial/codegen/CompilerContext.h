@@ -26,12 +26,16 @@
 #include <libpolynomial/ast/ASTForward.h>
 #include <libpolynomial/ast/Types.h>
 #include <libpolynomial/codegen/ABIFunctions.h>
+#include <libpolynomial/codegen/InlineAssemblyCache.h>
 
 #include <libpolynomial/interface/OptimiserSettings.h>
 
 #include <libsvmasm/Assembly.h>
 #include <libsvmasm/Instruction.h>
+#include <libyul/backends/svm/AbstractAssembly.h>
+#include <libyul/YulString.h>
 #include <liblangutil/SVMVersion.h>
+#include <liblangutil/SourceTable.h>
 #include <libdevcore/Common.h>
 
 #include <functional>
@@ -56,7 +60,9 @@ public:
 		m_asm(std::make_shared<sof::Assembly>()),
 		m_svmVersion(_svmVersion),
 		m_runtimeContext(_runtimeContext),
-		m_abiFunctions(m_svmVersion)
+		m_sourceTable(std::make_shared<langutil::SourceTable>()),
+		m_functionCollector(std::make_shared<MultiUseYulFunctionCollector>()),
+		m_abiFunctions(m_svmVersion, m_functionCollector)
 	{
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
@@ -64,6 +70,13 @@ public:
 
 	langutil::SVMVersion const& svmVersion() const { return m_svmVersion; }
 
+	/// Sets the table that owns the sources of the code of appendInlineAssembly if it is not cached.
+	void setSourceTable(std::shared_ptr<langutil::SourceTable> _sourceTable) { m_sourceTable = std::move(_sourceTable); }
+	/// Sets the cache for the code of appendInlineAssembly, nullptr disables caching.
+	void setInlineAssemblyCache(std::shared_ptr<InlineAssemblyCache> _cache) { m_inlineAssemblyCache = std::move(_cache); }
+	/// Sets the repository the ABI functions are shared through, nullptr disables sharing.
+	void setYulFunctionRepository(std::shared_ptr<YulFunctionRepository> _repository) { m_functionCollector->setRepository(std::move(_repository)); }
+
 	/// Update currently enabled set of experimental features.
 	void setExperimentalFeatures(std::set<ExperimentalFeature> const& _features) { m_experimentalFeatures = _features; }
 	/// @returns true if the given feature is enabled.
@@ -271,6 +284,14 @@ private:
 	);
 	/// @returns an iterator to the contract directly above the given contract.
 	std::vector<ContractDefinition const*>::const_iterator superContract(ContractDefinition const& _contract) const;
+	/// Parses, analyses and, if @a _optimise is true, optimises the code of appendInlineAssembly.
+	std::shared_ptr<InlineAssemblyCache::Entry const> parseAndOptimiseInlineAssembly(
+		std::string const& _assembly,
+		yul::ExternalIdentifierAccess const& _identifierAccess,
+		std::set<yul::YulString> const& _externallyUsedIdentifiers,
+		bool _optimise,
+		OptimiserSettings const& _optimiserSettings
+	) const;
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
@@ -328,14 +349,19 @@ private:
 	std::stack<ASTNode const*> m_visitedNodes;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
 	CompilerContext *m_runtimeContext;
+	/// Owner of the sources the locations of the generated code refer to.
+	std::shared_ptr<langutil::SourceTable> m_sourceTable;
 	/// The index of the runtime subroutine.
 	size_t m_runtimeSub = -1;
 	/// An index of low-level function labels by name.
 	std::map<std::string, sof::AssemblyItem> m_lowLevelFunctions;
+	/// Collector of the Yul functions requested by @a m_abiFunctions.
+	std::shared_ptr<MultiUseYulFunctionCollector> m_functionCollector;
 	/// Container for ABI functions to be generated.
 	ABIFunctions m_abiFunctions;
 	/// The queue of low-level functions to generate.
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 };
 
 }
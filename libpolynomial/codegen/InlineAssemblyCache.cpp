@@ -0,0 +1,73 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache for the inline assembly snippets generated by the code generator.
+ */
+
+#include <libpolynomial/codegen/InlineAssemblyCache.h>
+
+#include <tuple>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+
+bool InlineAssemblyCache::Key::operator<(Key const& _other) const
+{
+	return
+		tie(code, svmVersion, localVariables, optimise, creation, optimizeStackAllocation, expectedExecutionsPerDeployment, optimiserSteps, externallyUsedFunctions) <
+		tie(_other.code, _other.svmVersion, _other.localVariables, _other.optimise, _other.creation, _other.optimizeStackAllocation, _other.expectedExecutionsPerDeployment, _other.optimiserSteps, _other.externallyUsedFunctions);
+}
+
+shared_ptr<InlineAssemblyCache::Entry const> InlineAssemblyCache::find(Key const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	if (it == m_entries.end())
+	{
+		++m_misses;
+		return nullptr;
+	}
+	++m_hits;
+	return it->second;
+}
+
+void InlineAssemblyCache::insert(Key _key, shared_ptr<Entry const> _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(std::move(_key), std::move(_entry));
+}
+
+void InlineAssemblyCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.clear();
+	m_hits = 0;
+	m_misses = 0;
+}
+
+size_t InlineAssemblyCache::hits() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_hits;
+}
+
+size_t InlineAssemblyCache::misses() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_misses;
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Cache for the inline assembly snippets generated by the code generator.
+ */
+
+#pragma once
+
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmData.h>
+
+#include <liblangutil/SourceTable.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace polynomial
+{
+
+/**
+ * Stores the parsed, analysed and (possibly) optimised Yul code of the inline assembly
+ * snippets generated by CompilerContext::appendInlineAssembly, so that a snippet that is
+ * requested again (e.g. the same ABI routine in many contracts) is neither parsed nor
+ * optimised again. Entries are never modified after they were inserted, so they can be
+ * shared by all contracts of a compilation. Access is thread-safe.
+ *
+ * The cached code contains YulStrings, so a cache must not be used across a call to
+ * YulStringRepository::reset.
+ */
+class InlineAssemblyCache
+{
+public:
+	/// Everything the result of parsing, analysing and optimising a snippet depends on.
+	struct Key
+	{
+		std::string code;
+		std::string svmVersion;
+		/// Names of the variables of the surrounding code, affects the analysis.
+		std::vector<std::string> localVariables;
+		bool optimise = false;
+		/// The remaining fields only affect the optimiser and are only set if @a optimise is true.
+		bool creation = false;
+		bool optimizeStackAllocation = false;
+		size_t expectedExecutionsPerDeployment = 0;
+		std::string optimiserSteps;
+		std::set<std::string> externallyUsedFunctions;
+
+		bool operator<(Key const& _other) const;
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo const> analysisInfo;
+	};
+
+	/// @returns the entry for @a _key or nullptr if there is none. Counts a hit or a miss.
+	std::shared_ptr<Entry const> find(Key const& _key);
+	void insert(Key _key, std::shared_ptr<Entry const> _entry);
+	void clear();
+
+	size_t hits() const;
+	size_t misses() const;
+
+	/// @returns the table that owns the sources the locations in the cached code refer to.
+	/// The entries can outlive the compilation that created them, so they cannot be owned by it.
+	langutil::SourceTable& sources() { return m_sources; }
+
+private:
+	langutil::SourceTable m_sources;
+	mutable std::mutex m_mutex;
+	std::map<Key, std::shared_ptr<Entry const>> m_entries;
+	size_t m_hits = 0;
+	size_t m_misses = 0;
+};
+
+}
+}
@@ -23,6 +23,8 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -41,12 +43,39 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	if (!m_dependencyStack.empty())
+		m_dependencyStack.back()->insert(_name);
 	if (!m_requestedFunctions.count(_name))
 	{
-		string fun = _creator();
+		if (m_repository)
+			if (auto function = m_repository->find(_name))
+			{
+				addFromRepository(_name, *function);
+				return _name;
+			}
+
+		set<string> dependencies;
+		m_dependencyStack.push_back(&dependencies);
+		string fun;
+		{
+			ScopeGuard popDependencies([&]() { m_dependencyStack.pop_back(); });
+			fun = _creator();
+		}
 		polAssert(!fun.empty(), "");
 		polAssert(fun.find("function " + _name) != string::npos, "Function not properly named.");
+		if (m_repository)
+			m_repository->insert(_name, make_shared<YulFunctionRepository::Function>(
+				YulFunctionRepository::Function{fun, std::move(dependencies)}
+			));
 		m_requestedFunctions[_name] = std::move(fun);
 	}
 	return _name;
 }
+
+void MultiUseYulFunctionCollector::addFromRepository(string const& _name, YulFunctionRepository::Function const& _function)
+{
+	m_requestedFunctions[_name] = _function.code;
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+			addFromRepository(dependency, *m_repository->at(dependency));
+}
@@ -21,9 +21,14 @@
 
 #pragma once
 
+#include <libpolynomial/codegen/YulFunctionRepository.h>
+
 #include <functional>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -33,10 +38,20 @@ namespace polynomial
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
+ * If a repository is given, functions are taken from and added to the repository, so that
+ * collectors sharing a repository (e.g. those of all contracts of a compilation) only
+ * generate each function once.
  */
 class MultiUseYulFunctionCollector
 {
 public:
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<YulFunctionRepository> _repository = nullptr):
+		m_repository(std::move(_repository))
+	{}
+
+	/// Sets the repository shared with other collectors, nullptr disables sharing.
+	void setRepository(std::shared_ptr<YulFunctionRepository> _repository) { m_repository = std::move(_repository); }
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -48,8 +63,14 @@ public:
 	std::string requestedFunctions();
 
 private:
+	/// Adds @a _function and, recursively, all functions it depends on from the repository.
+	void addFromRepository(std::string const& _name, YulFunctionRepository::Function const& _function);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<YulFunctionRepository> m_repository;
+	/// Dependencies of the functions currently being created, innermost last.
+	std::vector<std::set<std::string>*> m_dependencyStack;
 };
 
 }
@@ -0,0 +1,82 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compilation-wide store of the (unparsed) Yul functions generated for the ABI coder and
+ * other utilities.
+ */
+
+#include <libpolynomial/codegen/YulFunctionRepository.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+
+shared_ptr<YulFunctionRepository::Function const> YulFunctionRepository::find(string const& _name)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	if (it == m_functions.end())
+	{
+		++m_misses;
+		return nullptr;
+	}
+	++m_hits;
+	return it->second;
+}
+
+void YulFunctionRepository::insert(string const& _name, shared_ptr<Function const> _function)
+{
+	polAssert(_function, "");
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_name, std::move(_function));
+}
+
+shared_ptr<YulFunctionRepository::Function const> YulFunctionRepository::at(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	polAssert(it != m_functions.end(), "Function \"" + _name + "\" not found in repository.");
+	return it->second;
+}
+
+void YulFunctionRepository::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.clear();
+	m_hits = 0;
+	m_misses = 0;
+}
+
+size_t YulFunctionRepository::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_functions.size();
+}
+
+size_t YulFunctionRepository::hits() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_hits;
+}
+
+size_t YulFunctionRepository::misses() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_misses;
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compilation-wide store of the (unparsed) Yul functions generated for the ABI coder and
+ * other utilities.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace dev
+{
+namespace polynomial
+{
+
+/**
+ * Stores the code of the multi-use Yul functions generated by MultiUseYulFunctionCollector
+ * together with the names of the functions they call, so that a function requested by
+ * several contracts of a compilation is only generated once. Functions are never modified
+ * after they were inserted. Access is thread-safe.
+ *
+ * The code of a function depends on the SVM version, so a repository must only be used
+ * for a single SVM version.
+ */
+class YulFunctionRepository
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the multi-use functions that are requested by @a code.
+		std::set<std::string> dependencies;
+	};
+
+	/// @returns the function called @a _name or nullptr if it has not been generated yet.
+	/// Counts a hit or a miss.
+	std::shared_ptr<Function const> find(std::string const& _name);
+	/// Stores @a _function under @a _name unless there already is a function of that name.
+	void insert(std::string const& _name, std::shared_ptr<Function const> _function);
+	/// @returns the function called @a _name, which has to be present, without counting a hit.
+	std::shared_ptr<Function const> at(std::string const& _name) const;
+	void clear();
+
+	size_t size() const;
+	size_t hits() const;
+	size_t misses() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+	size_t m_hits = 0;
+	size_t m_misses = 0;
+};
+
+}
+}
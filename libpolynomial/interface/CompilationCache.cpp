@@ -0,0 +1,71 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent, content-addressed store for the compilation results of single contracts.
+ */
+
+#include <libpolynomial/interface/CompilationCache.h>
+
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+
+namespace fs = boost::filesystem;
+
+boost::optional<Json::Value> CompilationCache::load(h256 const& _key) const
+{
+	Json::Value entry;
+	// A missing or truncated file just fails to parse.
+	if (!jsonParseFile(entryPath(_key), entry) || !entry.isObject())
+		return {};
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Json::Value const& _entry) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	fs::path const target = entryPath(_key);
+	fs::path const temporary = target.string() + fs::unique_path(".%%%%-%%%%-%%%%.tmp").string();
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << jsonCompactPrint(_entry);
+		if (!file.good())
+		{
+			file.close();
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	fs::rename(temporary, target, error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+string CompilationCache::entryPath(h256 const& _key) const
+{
+	return (fs::path(m_directory) / (_key.hex() + ".json")).string();
+}
@@ -0,0 +1,66 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent, content-addressed store for the compilation results of single contracts.
+ */
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/optional.hpp>
+
+#include <string>
+
+namespace dev
+{
+namespace polynomial
+{
+
+/**
+ * Directory of JSON documents, each stored in a file named after the (hex encoded) hash
+ * it is looked up by. The hash has to cover everything the document depends on, entries
+ * are never invalidated.
+ * Entries are written to a temporary file first and then renamed, so concurrent
+ * compiler processes can share the same directory.
+ */
+class CompilationCache
+{
+public:
+	/// Uses @a _directory as the cache directory, it is created on the first store.
+	explicit CompilationCache(std::string _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or nothing if there is no such entry
+	/// or it cannot be read.
+	boost::optional<Json::Value> load(h256 const& _key) const;
+
+	/// Stores @a _entry under @a _key. Failures to write are ignored, they only cause
+	/// future cache misses.
+	void store(h256 const& _key, Json::Value const& _entry) const;
+
+	std::string const& directory() const { return m_directory; }
+
+private:
+	std::string entryPath(h256 const& _key) const;
+
+	std::string m_directory;
+};
+
+}
+}
@@ -39,8 +39,11 @@
 #include <libpolynomial/ast/AST.h>
 #include <libpolynomial/ast/TypeProvider.h>
 #include <libpolynomial/codegen/Compiler.h>
+#include <libpolynomial/codegen/InlineAssemblyCache.h>
+#include <libpolynomial/codegen/YulFunctionRepository.h>
 #include <libpolynomial/formal/SMTChecker.h>
 #include <libpolynomial/interface/ABI.h>
+#include <libpolynomial/interface/CompilationCache.h>
 #include <libpolynomial/interface/Natspec.h>
 #include <libpolynomial/interface/GasEstimator.h>
 #include <libpolynomial/interface/Version.h>
@@ -49,6 +52,7 @@
 #include <libpolynomial/codegen/ir/IRGenerator.h>
 
 #include <libyul/YulString.h>
+#include <libyul/optimiser/OptimiserStatistics.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -58,11 +62,17 @@
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/IpfsHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
@@ -80,6 +90,9 @@ CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	// no more than one entity is actually using it at a time.
 	polAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
+	m_inlineAssemblyCache = make_shared<InlineAssemblyCache>();
+	m_sourceTable = make_shared<SourceTable>();
+	m_threadPool = make_shared<ThreadPool>(m_parallelism);
 }
 
 CompilerStack::~CompilerStack()
@@ -145,6 +158,33 @@ void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 	m_optimiserSettings = std::move(_settings);
 }
 
+void CompilerStack::setPipelineConfigs(map<string, PipelineConfig> _configs)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the pipeline configuration before compiling."));
+	m_pipelineConfigs = std::move(_configs);
+}
+
+void CompilerStack::setParallelism(unsigned _threads)
+{
+	if (m_stackState >= ParsingSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before parsing."));
+	polAssert(_threads > 0, "At least one thread is required.");
+	if (_threads != m_parallelism)
+		m_threadPool = make_shared<ThreadPool>(_threads);
+	m_parallelism = _threads;
+}
+
+void CompilerStack::setCacheDirectory(string const& _directory)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the cache directory before compiling."));
+	if (_directory.empty())
+		m_cache.reset();
+	else
+		m_cache = make_unique<CompilationCache>(_directory);
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsingSuccessful)
@@ -161,25 +201,47 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	bool const keepAnalysis = _keepSettings && m_incrementalAnalysis && retainAnalysis();
+	if (!keepAnalysis)
+	{
+		m_retainedAnalysis = RetainedAnalysis{};
+		m_sourceTable = make_shared<SourceTable>();
+	}
 	m_stackState = Empty;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_yulFunctionRepository.reset();
+	m_yulOptimiserStatistics.reset();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
 		m_libraries.clear();
 		m_svmVersion = langutil::SVMVersion();
 		m_generateIR = false;
+		m_pipelineConfigs.clear();
+		m_incrementalAnalysis = false;
+		m_parallelism = 1;
+		m_threadPool = make_shared<ThreadPool>(m_parallelism);
+		m_cache.reset();
+		m_profiling = false;
+		m_yulOptimiserStatisticsEnabled = false;
+		m_inlineAssemblyCache = make_shared<InlineAssemblyCache>();
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
-	m_globalContext.reset();
-	m_scopes.clear();
+	if (!keepAnalysis)
+	{
+		m_globalContext.reset();
+		m_scopes.clear();
+		TypeProvider::reset();
+	}
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_cacheHits = 0;
+	m_cacheMisses = 0;
+	m_profiler.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -197,8 +259,20 @@ bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
+	ProfilerScope profilerScope(activeProfiler());
+	ScopedPhase phase("parsing");
 	m_errorReporter.clear();
-	ASTNode::resetID();
+	if (!m_retainedAnalysis.sources.empty() && !retainedAnalysisApplicable())
+	{
+		m_retainedAnalysis = RetainedAnalysis{};
+		m_sourceTable = make_shared<SourceTable>();
+		m_globalContext.reset();
+		m_scopes.clear();
+		TypeProvider::reset();
+	}
+	// Retained ASTs keep their IDs, so new IDs must not collide with them.
+	if (m_retainedAnalysis.sources.empty())
+		ASTNode::resetID();
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
@@ -212,26 +286,75 @@ bool CompilerStack::parse()
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Sources are parsed in rounds: All sources known at the start of a round are parsed
+	// concurrently, then their errors are collected and their imports are loaded in the order
+	// of a sequential parse. Nodes get their final IDs in this step as well, so neither the
+	// order of the errors nor the IDs depend on the number of threads.
+	size_t lastID = ASTNode::lastID();
+	for (size_t roundStart = 0; roundStart < sourcesToParse.size();)
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter, m_svmVersion).parse(source.scanner);
-		if (!source.ast)
-			polAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		size_t const roundEnd = sourcesToParse.size();
+		vector<Source*> sourcesInRound;
+		for (size_t i = roundStart; i < roundEnd; ++i)
+		{
+			Source& source = m_sources[sourcesToParse[i]];
+			auto retained = m_retainedAnalysis.sources.find(sourcesToParse[i]);
+			if (
+				retained != m_retainedAnalysis.sources.end() &&
+				retained->second.scanner->source() == source.scanner->source()
+			)
+			{
+				source.scanner = retained->second.scanner;
+				source.ast = retained->second.ast;
+				source.retained = true;
+			}
+			sourcesInRound.push_back(&source);
+		}
+
+		vector<ErrorList> parserErrors(sourcesInRound.size());
+		vector<size_t> nodeCounts(sourcesInRound.size(), 0);
+		m_threadPool->run(sourcesInRound.size(), [&](size_t _index)
+		{
+			Source& source = *sourcesInRound[_index];
+			if (source.retained)
+				return;
+			ErrorReporter errorReporter(parserErrors[_index]);
+			ASTNode::resetID();
+			m_sourceTable->add(source.scanner->charStream());
+			source.scanner->reset();
+			source.ast = Parser(errorReporter, m_svmVersion).parse(source.scanner);
+			nodeCounts[_index] = ASTNode::lastID();
+		});
+
+		for (size_t i = roundStart; i < roundEnd; ++i)
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			string const path = sourcesToParse[i];
+			Source& source = *sourcesInRound[i - roundStart];
+			if (!source.retained)
+			{
+				m_errorReporter.append(parserErrors[i - roundStart]);
+				if (source.ast)
+					ASTNode::shiftIDs(*source.ast, lastID);
+				lastID += nodeCounts[i - roundStart];
+			}
+			if (!source.ast)
+				polAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-				sourcesToParse.push_back(newPath);
+				source.ast->annotation().path = path;
+				for (auto const& newSource: loadMissingSources(*source.ast, path))
+				{
+					string const& newPath = newSource.first;
+					string const& newContents = newSource.second;
+					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+					sourcesToParse.push_back(newPath);
+				}
 			}
 		}
+		roundStart = roundEnd;
 	}
+	ASTNode::resetID(lastID);
+	invalidateRetainedImporters();
 	if (Error::containsOnlyWarnings(m_errorReporter.errors()))
 	{
 		m_stackState = ParsingSuccessful;
@@ -245,60 +368,81 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingSuccessful || m_stackState >= AnalysisSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was successful."));
+	ProfilerScope profilerScope(activeProfiler());
 	resolveImports();
 
+	// Retained sources are skipped by the analysis steps below, so their diagnostics
+	// have to be taken from the previous compilation.
+	for (auto const& error: m_retainedAnalysis.errors)
+		if (isInRetainedSource(*error))
+			m_errorReporter.append({error});
+
 	bool noErrors = true;
 
 	try {
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (!syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			ScopedPhase phase("syntaxChecker");
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			ScopedPhase phase("docStringAnalyser");
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained && !docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+		}
 
-		m_globalContext = make_shared<GlobalContext>();
-		NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.registerDeclarations(*source->ast))
-				return false;
-
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (!resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
-
-		// This is the main name and type resolution loop. Needs to be run for every contract, because
-		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-				{
+		{
+			ScopedPhase phase("nameAndTypeResolver");
+			if (!m_globalContext)
+				m_globalContext = make_shared<GlobalContext>();
+			NameAndTypeResolver resolver(*m_globalContext, m_scopes, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-					if (!resolver.resolveNamesAndTypes(*contract)) return false;
-					// Note that we now reference contracts by their fully qualified names, and
-					// thus contracts can only conflict if declared in the same source file.  This
-					// already causes a double-declaration error elsewhere, so we do not report
-					// an error here and instead silently drop any additional contracts we find.
-					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-						m_contracts[contract->fullyQualifiedName()].contract = contract;
-				}
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		// Next, we check inheritance, overrides, function collisions and other things at
-		// contract or function level.
-		// This also calculates whether a contract is abstract, which is needed by the
-		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!contractLevelChecker.check(*contract))
-						noErrors = false;
+			// This is the main name and type resolution loop. Needs to be run for every contract, because
+			// the special variables "this" and "super" must be set appropriately.
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					{
+
+						if (!source->retained && !resolver.resolveNamesAndTypes(*contract)) return false;
+						// Note that we now reference contracts by their fully qualified names, and
+						// thus contracts can only conflict if declared in the same source file.  This
+						// already causes a double-declaration error elsewhere, so we do not report
+						// an error here and instead silently drop any additional contracts we find.
+						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+							m_contracts[contract->fullyQualifiedName()].contract = contract;
+					}
+		}
+
+		{
+			// Next, we check inheritance, overrides, function collisions and other things at
+			// contract or function level.
+			// This also calculates whether a contract is abstract, which is needed by the
+			// type checker.
+			ScopedPhase phase("contractLevelChecker");
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!contractLevelChecker.check(*contract))
+								noErrors = false;
+		}
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -307,19 +451,24 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_svmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		{
+			ScopedPhase phase("typeChecker");
+			TypeChecker typeChecker(m_svmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				if (!source->retained)
+					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+							if (!typeChecker.checkTypeRequirements(*contract))
+								noErrors = false;
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			ScopedPhase phase("postTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!postTypeChecker.check(*source->ast))
+				if (!source->retained && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 		}
 
@@ -327,16 +476,17 @@ bool CompilerStack::analyze()
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			ScopedPhase phase("controlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!cfg.constructFlow(*source->ast))
+				if (!source->retained && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
 				for (Source const* source: m_sourceOrder)
-					if (!controlFlowAnalyzer.analyze(*source->ast))
+					if (!source->retained && !controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
 		}
@@ -344,28 +494,39 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			ScopedPhase phase("staticAnalyzer");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (!staticAnalyzer.analyze(*source->ast))
+				if (!source->retained && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
 
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			ScopedPhase phase("viewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				ast.push_back(source->ast);
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			// Retained sources are needed to infer the mutability of modifiers,
+			// but their diagnostics are already known.
+			ErrorList viewPureErrors;
+			ErrorReporter viewPureReporter(viewPureErrors);
+			if (!ViewPureChecker(ast, viewPureReporter).check())
 				noErrors = false;
+			for (auto const& error: viewPureErrors)
+				if (!isInRetainedSource(*error))
+					m_errorReporter.append({error});
 		}
 
 		if (noErrors)
 		{
+			ScopedPhase phase("smtChecker");
 			SMTChecker smtChecker(m_errorReporter, m_smtlib2Responses);
 			for (Source const* source: m_sourceOrder)
-				smtChecker.analyze(*source->ast, source->scanner);
+				if (!source->retained)
+					smtChecker.analyze(*source->ast, source->scanner);
 			m_unhandledSMTLib2Queries += smtChecker.unhandledQueries();
 		}
 	}
@@ -399,25 +560,70 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 		m_requestedContractNames.count(":" + _contract.name());
 }
 
+CompilerStack::PipelineConfig CompilerStack::pipelineConfig(ContractDefinition const& _contract) const
+{
+	auto it = m_pipelineConfigs.find(_contract.fullyQualifiedName());
+	if (it != m_pipelineConfigs.end())
+		return it->second;
+	PipelineConfig config;
+	config.irCodegen = m_generateIR;
+	return config;
+}
+
 bool CompilerStack::compile()
 {
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze())
 			return false;
 
+	ProfilerScope profilerScope(activeProfiler());
+	// The ABI functions depend on the SVM version, so they are only shared within a compilation.
+	m_yulFunctionRepository = make_shared<YulFunctionRepository>();
+	if (m_yulOptimiserStatisticsEnabled)
+		m_yulOptimiserStatistics = make_shared<yul::OptimiserStatistics>();
+
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	vector<ContractDefinition const*> compiledContracts;
+	vector<ContractDefinition const*> cachedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR)
+					PipelineConfig const config = pipelineConfig(*contract);
+					if (config.bytecode)
+					{
+						if (!otherCompilers.count(contract) && loadFromCache(*contract))
+							cachedContracts.push_back(contract);
+						else
+							compileContract(*contract, otherCompilers, compiledContracts);
+					}
+					if (config.irCodegen)
 						generateIR(*contract);
 				}
+	// The code generator only embeds references to the assemblies of other contracts,
+	// so optimising them can be deferred until the code of all contracts is generated.
+	optimiseAndAssemble(compiledContracts);
 	m_stackState = CompilationSuccessful;
-	this->link();
+	{
+		ScopedPhase phase("linking");
+		this->link();
+	}
+
+	if (m_cache)
+	{
+		// Contracts loaded from the cache might have been compiled later on as a dependency
+		// of another contract, in which case they are counted as misses.
+		m_cacheHits = count_if(
+			cachedContracts.begin(),
+			cachedContracts.end(),
+			[&](ContractDefinition const* _contract) { return !otherCompilers.count(_contract); }
+		);
+		m_cacheMisses = compiledContracts.size();
+		for (ContractDefinition const* contract: compiledContracts)
+			storeInCache(*contract);
+	}
 	return true;
 }
 
@@ -480,6 +686,8 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	Contract const& c = contract(_contractName);
 	if (!c.sourceMapping)
 	{
+		ProfilerScope profilerScope(activeProfiler(), _contractName);
+		ScopedPhase phase("sourceMapping");
 		if (auto items = assemblyItems(_contractName))
 			c.sourceMapping.reset(new string(computeSourceMapping(*items)));
 	}
@@ -494,6 +702,8 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	Contract const& c = contract(_contractName);
 	if (!c.runtimeSourceMapping)
 	{
+		ProfilerScope profilerScope(activeProfiler(), _contractName);
+		ScopedPhase phase("sourceMapping");
 		if (auto items = runtimeAssemblyItems(_contractName))
 			c.runtimeSourceMapping.reset(new string(computeSourceMapping(*items)));
 	}
@@ -565,6 +775,8 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
 		return currentContract.compiler->assemblyString(_sourceCodes);
+	else if (currentContract.cachedOutputs)
+		return (*currentContract.cachedOutputs)["assembly"].asString();
 	else
 		return string();
 }
@@ -578,6 +790,8 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap c
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.compiler)
 		return currentContract.compiler->assemblyJSON(_sourceCodes);
+	else if (currentContract.cachedOutputs)
+		return (*currentContract.cachedOutputs)["legacyAssembly"];
 	else
 		return Json::Value();
 }
@@ -749,8 +963,9 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 	int startColumn;
 	int endLine;
 	int endColumn;
-	tie(startLine, startColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.start);
-	tie(endLine, endColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.end);
+	Scanner const& sourceScanner = scanner(_sourceLocation.source->name());
+	tie(startLine, startColumn) = sourceScanner.translatePositionToLineColumn(_sourceLocation.start);
+	tie(endLine, endColumn) = sourceScanner.translatePositionToLineColumn(_sourceLocation.end);
 
 	return make_tuple(++startLine, ++startColumn, ++endLine, ++endColumn);
 }
@@ -887,6 +1102,93 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+bool CompilerStack::retainAnalysis()
+{
+	if (m_stackState >= AnalysisSuccessful)
+	{
+		set<SourceUnit const*> analysedASTs;
+		for (auto const& source: m_sources)
+			analysedASTs.insert(source.second.ast.get());
+		for (auto const& source: m_retainedAnalysis.sources)
+			if (!analysedASTs.count(source.second.ast.get()))
+				m_retainedAnalysis.supersededASTs.push_back(source.second.ast);
+
+		m_retainedAnalysis.sources = std::move(m_sources);
+		m_retainedAnalysis.errors = m_errorReporter.errors();
+		m_retainedAnalysis.svmVersion = m_svmVersion;
+		m_retainedAnalysis.remappings = m_remappings;
+		m_retainedAnalysis.runYulOptimiser = m_optimiserSettings.runYulOptimiser;
+		m_retainedAnalysis.smtlib2Responses = m_smtlib2Responses;
+	}
+	else
+		// The previously retained analysis is still valid, since retained sources are not
+		// modified by the analysis of other sources.
+		for (auto const& source: m_sources)
+			if (source.second.ast && !source.second.retained)
+				m_retainedAnalysis.supersededASTs.push_back(source.second.ast);
+
+	// Start from scratch once more memory is used for outdated ASTs than for current ones.
+	return m_retainedAnalysis.supersededASTs.size() <= m_retainedAnalysis.sources.size();
+}
+
+bool CompilerStack::retainedAnalysisApplicable() const
+{
+	auto sameRemappings = [](vector<Remapping> const& _a, vector<Remapping> const& _b)
+	{
+		return equal(_a.begin(), _a.end(), _b.begin(), _b.end(), [](Remapping const& _x, Remapping const& _y) {
+			return _x.context == _y.context && _x.prefix == _y.prefix && _x.target == _y.target;
+		});
+	};
+	return
+		m_retainedAnalysis.svmVersion == m_svmVersion &&
+		sameRemappings(m_retainedAnalysis.remappings, m_remappings) &&
+		m_retainedAnalysis.runYulOptimiser == m_optimiserSettings.runYulOptimiser &&
+		m_retainedAnalysis.smtlib2Responses == m_smtlib2Responses;
+}
+
+void CompilerStack::invalidateRetainedImporters()
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto& sourcePair: m_sources)
+		{
+			Source& source = sourcePair.second;
+			if (!source.retained)
+				continue;
+			for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+				if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
+				{
+					auto imported = m_sources.find(import->annotation().absolutePath);
+					if (imported != m_sources.end() && imported->second.retained)
+						continue;
+
+					// The content did not change, so neither do the imports nor any errors.
+					string const& path = sourcePair.first;
+					source.retained = false;
+					source.scanner = make_shared<Scanner>(CharStream(source.scanner->source(), path));
+					m_sourceTable->add(source.scanner->charStream());
+					source.ast = Parser(m_errorReporter, m_svmVersion).parse(source.scanner);
+					polAssert(source.ast, "");
+					source.ast->annotation().path = path;
+					polAssert(loadMissingSources(*source.ast, path).empty(), "");
+					changed = true;
+					break;
+				}
+		}
+	}
+}
+
+bool CompilerStack::isInRetainedSource(Error const& _error) const
+{
+	SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+	if (!location || !location->source)
+		return false;
+	auto source = m_sources.find(location->source->name());
+	return source != m_sources.end() && source->second.retained;
+}
+
 namespace
 {
 bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& features)
@@ -900,7 +1202,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	vector<ContractDefinition const*>& o_compiledContracts
 )
 {
 	polAssert(m_stackState >= AnalysisSuccessful, "");
@@ -908,22 +1211,149 @@ void CompilerStack::compileContract(
 	if (_otherCompilers.count(&_contract) || !_contract.canBeDeployed())
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, o_compiledContracts);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_svmVersion, m_optimiserSettings);
+	ProfilerScope profilerScope(activeProfiler(), _contract.fullyQualifiedName());
+
+	OptimiserSettings optimiserSettings = m_optimiserSettings;
+	optimiserSettings.yulOptimiserThreadPool = m_threadPool;
+	optimiserSettings.yulOptimiserStatistics = m_yulOptimiserStatistics;
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_svmVersion,
+		optimiserSettings,
+		m_inlineAssemblyCache,
+		m_yulFunctionRepository,
+		m_sourceTable
+	);
 	compiledContract.compiler = compiler;
+	compiledContract.cachedOutputs.reset();
+	compiledContract.sourceMapping.reset();
+	compiledContract.runtimeSourceMapping.reset();
 
-	bytes cborEncodedMetadata = createCBORMetadata(
-		metadata(compiledContract),
-		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
-	);
+	bytes cborEncodedMetadata;
+	{
+		ScopedPhase phase("metadata");
+		cborEncodedMetadata = createCBORMetadata(
+			metadata(compiledContract),
+			!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
+		);
+	}
+
+	ScopedPhase phase("codeGeneration");
+	compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+
+	_otherCompilers[compiledContract.contract] = compiler;
+	o_compiledContracts.push_back(&_contract);
+}
+
+void CompilerStack::optimiseAndAssemble(vector<ContractDefinition const*> const& _contracts)
+{
+	size_t const threadCount = min<size_t>(m_parallelism, _contracts.size());
+	if (threadCount <= 1)
+	{
+		for (ContractDefinition const* contract: _contracts)
+			optimiseAndAssemble(*contract);
+		return;
+	}
+
+	// The assembly of a contract shares the assemblies of all contracts it creates
+	// (transitively) and optimising or assembling it modifies those as well. Two contracts
+	// that share an assembly are processed one after the other in the original order,
+	// which keeps the output identical to the sequential compilation.
+	vector<set<ContractDefinition const*>> touchedContracts;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		set<ContractDefinition const*> touched;
+		function<void(ContractDefinition const*)> visit = [&](ContractDefinition const* _contract)
+		{
+			if (touched.insert(_contract).second)
+				for (auto const* dependency: _contract->annotation().contractDependencies)
+					visit(dependency);
+		};
+		visit(contract);
+		touchedContracts.emplace_back(std::move(touched));
+	}
+	vector<vector<size_t>> predecessors(_contracts.size());
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		for (size_t j = 0; j < i; ++j)
+			if (any_of(
+				touchedContracts[i].begin(),
+				touchedContracts[i].end(),
+				[&](ContractDefinition const* _contract) { return touchedContracts[j].count(_contract); }
+			))
+				predecessors[i].push_back(j);
+
+	mutex stateMutex;
+	condition_variable stateChanged;
+	vector<bool> started(_contracts.size(), false);
+	vector<bool> finished(_contracts.size(), false);
+	exception_ptr failure;
+
+	auto worker = [&]()
+	{
+		unique_lock<mutex> lock(stateMutex);
+		while (!failure)
+		{
+			bool allStarted = true;
+			size_t next = _contracts.size();
+			for (size_t i = 0; i < _contracts.size() && next == _contracts.size(); ++i)
+				if (!started[i])
+				{
+					allStarted = false;
+					if (all_of(
+						predecessors[i].begin(),
+						predecessors[i].end(),
+						[&](size_t _predecessor) { return finished[_predecessor]; }
+					))
+						next = i;
+				}
+			if (allStarted)
+				return;
+			if (next == _contracts.size())
+			{
+				stateChanged.wait(lock);
+				continue;
+			}
+
+			started[next] = true;
+			lock.unlock();
+			exception_ptr error;
+			try
+			{
+				optimiseAndAssemble(*_contracts[next]);
+			}
+			catch (...)
+			{
+				error = current_exception();
+			}
+			lock.lock();
+			finished[next] = true;
+			if (error && !failure)
+				failure = error;
+			stateChanged.notify_all();
+		}
+	};
+
+	m_threadPool->run(threadCount, [&](size_t) { worker(); });
+
+	if (failure)
+		rethrow_exception(failure);
+}
+
+void CompilerStack::optimiseAndAssemble(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	shared_ptr<Compiler> const& compiler = compiledContract.compiler;
+	polAssert(compiler, "");
+	// This might run on a worker thread.
+	ProfilerScope profilerScope(activeProfiler(), _contract.fullyQualifiedName());
 
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser.
+		ScopedPhase phase("assemblyOptimiser");
+		compiler->optimise();
 	}
 	catch(sof::OptimizerException const&)
 	{
@@ -933,6 +1363,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
+		ScopedPhase phase("assembling");
 		compiledContract.object = compiler->assembledObject();
 	}
 	catch(sof::AssemblyException const&)
@@ -943,14 +1374,13 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Assemble runtime object.
+		ScopedPhase phase("assembling");
 		compiledContract.runtimeObject = compiler->runtimeObject();
 	}
 	catch(sof::AssemblyException const&)
 	{
 		polAssert(false, "Assembly exception for deployed bytecode");
 	}
-
-	_otherCompilers[compiledContract.contract] = compiler;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -967,10 +1397,180 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		generateIR(*dependency);
 
+	ProfilerScope profilerScope(activeProfiler(), _contract.fullyQualifiedName());
+	ScopedPhase phase("irGeneration");
 	IRGenerator generator(m_svmVersion, m_optimiserSettings);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract);
 }
 
+namespace
+{
+Json::Value linkerObjectToJson(sof::LinkerObject const& _object)
+{
+	Json::Value ret(Json::objectValue);
+	ret["bytecode"] = toHex(_object.bytecode);
+	ret["linkReferences"] = Json::objectValue;
+	for (auto const& reference: _object.linkReferences)
+		ret["linkReferences"][to_string(reference.first)] = reference.second;
+	return ret;
+}
+
+bool linkerObjectFromJson(Json::Value const& _json, sof::LinkerObject& o_object)
+{
+	if (!_json["bytecode"].isString() || !_json["linkReferences"].isObject())
+		return false;
+	o_object.bytecode = fromHex(_json["bytecode"].asString());
+	o_object.linkReferences.clear();
+	for (auto const& offset: _json["linkReferences"].getMemberNames())
+	{
+		if (offset.empty() || !all_of(offset.begin(), offset.end(), ::isdigit))
+			return false;
+		o_object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+	}
+	return true;
+}
+
+/// Replaces the source indices in the compressed source mapping @a _mapping, which refer to
+/// the sources in @a _sourceList, by the indices of the same sources in @a _sourceIndices.
+/// The compression stays valid as equal indices are translated to equal indices.
+/// @returns nothing if a referenced source is unknown.
+boost::optional<string> translateSourceIndices(
+	string const& _mapping,
+	Json::Value const& _sourceList,
+	map<string, unsigned> const& _sourceIndices
+)
+{
+	vector<string> items;
+	boost::split(items, _mapping, boost::is_any_of(";"));
+	for (string& item: items)
+	{
+		vector<string> fields;
+		boost::split(fields, item, boost::is_any_of(":"));
+		if (fields.size() < 3 || fields[2].empty() || fields[2] == "-1")
+			continue;
+		if (!all_of(fields[2].begin(), fields[2].end(), ::isdigit))
+			return {};
+		Json::ArrayIndex index = stoul(fields[2]);
+		if (index >= _sourceList.size() || !_sourceIndices.count(_sourceList[index].asString()))
+			return {};
+		fields[2] = to_string(_sourceIndices.at(_sourceList[index].asString()));
+		item = boost::algorithm::join(fields, ":");
+	}
+	return boost::algorithm::join(items, ";");
+}
+}
+
+h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	// The metadata covers the sources (transitively), the SVM version, the libraries
+	// and parts of the optimiser settings.
+	Json::Value key(Json::objectValue);
+	key["compiler"] = VersionString;
+	key["release"] = m_release;
+	key["metadata"] = metadata(_contract);
+	key["ir"] = pipelineConfig(*_contract.contract).irCodegen;
+	Json::Value& optimizer = key["optimizer"];
+	optimizer["orderLiterals"] = m_optimiserSettings.runOrderLiterals;
+	optimizer["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
+	optimizer["peephole"] = m_optimiserSettings.runPeephole;
+	optimizer["deduplicate"] = m_optimiserSettings.runDeduplicate;
+	optimizer["cse"] = m_optimiserSettings.runCSE;
+	optimizer["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+	optimizer["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+	optimizer["yul"] = m_optimiserSettings.runYulOptimiser;
+	optimizer["runs"] = Json::UInt64(m_optimiserSettings.expectedExecutionsPerDeployment);
+	return keccak256(jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCache(ContractDefinition const& _contract)
+{
+	if (!m_cache || !_contract.canBeDeployed())
+		return false;
+
+	Contract& cachedContract = m_contracts.at(_contract.fullyQualifiedName());
+	ProfilerScope profilerScope(activeProfiler(), _contract.fullyQualifiedName());
+	ScopedPhase phase("cacheLookup");
+	boost::optional<Json::Value> entry = m_cache->load(cacheKey(cachedContract));
+	if (!entry)
+		return false;
+
+	sof::LinkerObject object;
+	sof::LinkerObject runtimeObject;
+	if (
+		!linkerObjectFromJson((*entry)["object"], object) ||
+		!linkerObjectFromJson((*entry)["runtimeObject"], runtimeObject) ||
+		!(*entry)["sources"].isArray()
+	)
+		return false;
+	map<string, unsigned> indices = sourceIndices();
+	boost::optional<string> sourceMapping =
+		translateSourceIndices((*entry)["sourceMap"].asString(), (*entry)["sources"], indices);
+	boost::optional<string> runtimeSourceMapping =
+		translateSourceIndices((*entry)["runtimeSourceMap"].asString(), (*entry)["sources"], indices);
+	if (!sourceMapping || !runtimeSourceMapping)
+		return false;
+	bool const irCodegen = pipelineConfig(_contract).irCodegen;
+	if (irCodegen && !(*entry)["ir"].isString())
+		return false;
+
+	cachedContract.object = std::move(object);
+	cachedContract.runtimeObject = std::move(runtimeObject);
+	cachedContract.sourceMapping = make_unique<string const>(std::move(*sourceMapping));
+	cachedContract.runtimeSourceMapping = make_unique<string const>(std::move(*runtimeSourceMapping));
+	if (irCodegen)
+	{
+		cachedContract.yulIR = (*entry)["ir"].asString();
+		cachedContract.yulIROptimized = (*entry)["irOptimized"].asString();
+	}
+	Json::Value outputs(Json::objectValue);
+	outputs["assembly"] = std::move((*entry)["assembly"]);
+	outputs["legacyAssembly"] = std::move((*entry)["legacyAssembly"]);
+	outputs["gasEstimates"] = std::move((*entry)["gasEstimates"]);
+	cachedContract.cachedOutputs = make_unique<Json::Value const>(std::move(outputs));
+	return true;
+}
+
+void CompilerStack::storeInCache(ContractDefinition const& _contract) const
+{
+	polAssert(m_cache, "");
+	polAssert(m_stackState == CompilationSuccessful, "");
+
+	string const& name = _contract.fullyQualifiedName();
+	Contract const& compiledContract = m_contracts.at(name);
+	ProfilerScope profilerScope(activeProfiler(), name);
+	ScopedPhase phase("cacheStore");
+	polAssert(compiledContract.compiler, "");
+	bool const irCodegen = pipelineConfig(_contract).irCodegen;
+	// The IR is only generated for dependencies if the depending contract requests it.
+	if (irCodegen && compiledContract.yulIR.empty())
+		return;
+
+	// The cached assembly is annotated using all sources, which is what the
+	// command line and standard JSON interfaces request.
+	StringMap sourceCodes;
+	for (auto const& source: m_sources)
+		sourceCodes[source.first] = source.second.scanner->source();
+
+	Json::Value entry(Json::objectValue);
+	for (string const& sourceName: sourceNames())
+		entry["sources"].append(sourceName);
+	entry["object"] = linkerObjectToJson(compiledContract.object);
+	entry["runtimeObject"] = linkerObjectToJson(compiledContract.runtimeObject);
+	string const* mapping = sourceMapping(name);
+	entry["sourceMap"] = mapping ? *mapping : "";
+	mapping = runtimeSourceMapping(name);
+	entry["runtimeSourceMap"] = mapping ? *mapping : "";
+	entry["assembly"] = compiledContract.compiler->assemblyString(sourceCodes);
+	entry["legacyAssembly"] = compiledContract.compiler->assemblyJSON(sourceCodes);
+	entry["gasEstimates"] = gasEstimates(name);
+	if (irCodegen)
+	{
+		entry["ir"] = compiledContract.yulIR;
+		entry["irOptimized"] = compiledContract.yulIROptimized;
+	}
+	m_cache->store(cacheKey(compiledContract), entry);
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	polAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1069,6 +1669,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.yulOptimiserSteps != yul::OptimiserSuite::DefaultSequence)
+				details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1201,6 +1803,8 @@ string CompilerStack::computeSourceMapping(sof::AssemblyItems const& _items) con
 
 	string ret;
 	map<string, unsigned> sourceIndicesMap = sourceIndices();
+	// Source indices by source, so that the name of every source is only looked up once.
+	map<CharStream const*, int> sourceIndexBySource;
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
@@ -1212,10 +1816,14 @@ string CompilerStack::computeSourceMapping(sof::AssemblyItems const& _items) con
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && sourceIndicesMap.count(location.source->name()) ?
-			sourceIndicesMap.at(location.source->name()) :
-			-1;
+		CharStream const* source = location.source.get();
+		auto cachedSourceIndex = sourceIndexBySource.find(source);
+		if (cachedSourceIndex == sourceIndexBySource.end())
+			cachedSourceIndex = sourceIndexBySource.emplace(
+				source,
+				source && sourceIndicesMap.count(source->name()) ? int(sourceIndicesMap.at(source->name())) : -1
+			).first;
+		int sourceIndex = cachedSourceIndex->second;
 		char jump = '-';
 		if (item.getJumpType() == sof::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -1288,6 +1896,9 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
+	if (auto const& cachedOutputs = contract(_contractName).cachedOutputs)
+		return (*cachedOutputs)["gasEstimates"];
+
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
 		return Json::Value();
 
@@ -30,11 +30,13 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/SVMVersion.h>
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/SourceTable.h>
 
 #include <libsvmasm/LinkerObject.h>
 
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Profiler.h>
 
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
@@ -53,6 +55,8 @@ class Scanner;
 namespace dev
 {
 
+class ThreadPool;
+
 namespace sof
 {
 class Assembly;
@@ -72,6 +76,9 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class CompilationCache;
+class InlineAssemblyCache;
+class YulFunctionRepository;
 
 /**
  * Easy to use and self-contained Polynomial compiler with as few header dependencies as possible.
@@ -96,6 +103,15 @@ public:
 		std::string target;
 	};
 
+	/// The compilation stages to run for a single contract after the analysis.
+	struct PipelineConfig
+	{
+		/// Generate (and optimize) the experimental Yul IR.
+		bool irCodegen = false;
+		/// Generate, optimize and assemble the bytecode.
+		bool bytecode = true;
+	};
+
 	/// Creates a new compiler stack.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
@@ -146,6 +162,46 @@ public:
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Sets the compilation stages to run for the contracts with the given fully qualified names.
+	/// Other contracts generate bytecode and, if enabled, IR. Dependencies of a contract are
+	/// compiled as far as it requires them.
+	/// Must be set before compiling.
+	void setPipelineConfigs(std::map<std::string, PipelineConfig> _configs);
+
+	/// Enables incremental analysis: If the compiler is reset with @a _keepSettings set to true,
+	/// the ASTs and analysis results of the previously analysed sources are kept. Sources whose
+	/// content and imports (transitively) did not change are then neither parsed nor analysed again.
+	/// Note that AST IDs are not re-assigned from scratch in this case and that the
+	/// YulStringRepository must not be reset in between.
+	void enableIncrementalAnalysis(bool _enable = true) { m_incrementalAnalysis = _enable; }
+
+	/// Sets the number of threads used to parse the sources and to optimise and assemble the
+	/// compiled contracts. Contracts that do not create each other (or a common third contract)
+	/// are processed concurrently. The Yul optimiser uses the same threads for the
+	/// functions of a piece of Yul code. The output does not depend on this setting.
+	/// Must be set before parsing.
+	void setParallelism(unsigned _threads);
+
+	/// Enables the persistent compilation cache in the directory @a _directory (which is
+	/// created if needed). The compilation results of every contract are stored there and
+	/// re-used by later compilations with identical sources and settings.
+	/// An empty string disables the cache. Must be set before compiling.
+	void setCacheDirectory(std::string const& _directory);
+
+	/// Enables recording the time, number of invocations and peak memory usage of the
+	/// individual compilation phases, see @a profiler.
+	void enableProfiling(bool _enable = true) { m_profiling = _enable; }
+
+	/// Enables recording the time and the effect of every step of the Yul optimiser,
+	/// see @a yulOptimiserStatistics.
+	void enableYulOptimiserStatistics(bool _enable = true) { m_yulOptimiserStatisticsEnabled = _enable; }
+
+	/// Sets the cache for the inline assembly generated by the code generator. By default,
+	/// every compiler stack has its own cache, which is kept across compilations unless the
+	/// settings are reset. A cache can be shared by several compiler stacks, but not across
+	/// a reset of the YulStringRepository. nullptr disables caching.
+	void setInlineAssemblyCache(std::shared_ptr<InlineAssemblyCache> _cache) { m_inlineAssemblyCache = std::move(_cache); }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -262,6 +318,29 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns the number of contracts whose compilation results were taken from the cache
+	/// during the last compilation.
+	unsigned cacheHits() const { return m_cacheHits; }
+
+	/// @returns the number of contracts that were compiled and stored in the cache during the
+	/// last compilation.
+	unsigned cacheMisses() const { return m_cacheMisses; }
+
+	/// @returns the statistics of the compilation phases run since the last reset.
+	/// Only filled if profiling is enabled.
+	Profiler const& profiler() const { return m_profiler; }
+
+	/// @returns the cache for the generated inline assembly, nullptr if caching is disabled.
+	std::shared_ptr<InlineAssemblyCache const> inlineAssemblyCache() const { return m_inlineAssemblyCache; }
+
+	/// @returns the repository of the ABI functions generated during the last compilation,
+	/// nullptr if nothing has been compiled yet.
+	std::shared_ptr<YulFunctionRepository const> yulFunctionRepository() const { return m_yulFunctionRepository; }
+
+	/// @returns the statistics of the Yul optimiser runs of the last compilation, nullptr if
+	/// they are not recorded. Inline assembly taken from the cache is not optimised again.
+	std::shared_ptr<yul::OptimiserStatistics const> yulOptimiserStatistics() const { return m_yulOptimiserStatistics; }
+
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
@@ -270,6 +349,9 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// Whether the AST and its analysis were kept from a previous compilation, see
+		/// enableIncrementalAnalysis.
+		bool retained = false;
 		h256 mutable keccak256HashCached;
 		h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -279,6 +361,22 @@ private:
 		std::string const& ipfsUrl() const;
 	};
 
+	/// The analysed sources of a previous compilation, kept for incremental analysis.
+	struct RetainedAnalysis
+	{
+		std::map<std::string const, Source> sources;
+		/// The diagnostics of the previous compilation.
+		langutil::ErrorList errors;
+		/// The settings the analysis depends on.
+		langutil::SVMVersion svmVersion;
+		std::vector<Remapping> remappings;
+		bool runYulOptimiser = false;
+		std::map<h256, std::string> smtlib2Responses;
+		/// ASTs that were replaced by new versions. They are not freed since scopes and types
+		/// might still refer to them.
+		std::vector<std::shared_ptr<SourceUnit>> supersededASTs;
+	};
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
@@ -294,6 +392,9 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		/// Outputs otherwise derived from the assembly, only set if the contract was loaded from
+		/// the compilation cache (in which case there is no compiler).
+		std::unique_ptr<Json::Value const> cachedOutputs;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -303,17 +404,52 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Moves the analysed sources to @a m_retainedAnalysis, see enableIncrementalAnalysis.
+	/// @returns false if nothing is retained and the global analysis state has to be reset.
+	bool retainAnalysis();
+	/// @returns true if the retained analysis was performed with the current settings.
+	bool retainedAnalysisApplicable() const;
+	/// Marks those sources as not retained that import a source that is not retained
+	/// and parses them again.
+	void invalidateRetainedImporters();
+	/// @returns true if the primary location of @a _error is inside a retained source.
+	bool isInRetainedSource(langutil::Error const& _error) const;
+
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
-	/// Compile a single contract.
+	/// @returns the compilation stages to run for the given contract.
+	PipelineConfig pipelineConfig(ContractDefinition const& _contract) const;
+
+	/// Generate the code for a single contract and the contracts it depends on.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param o_compiledContracts is extended by the contracts whose code was generated, in order.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::vector<ContractDefinition const*>& o_compiledContracts
 	);
 
+	/// Runs the optimiser on and assembles the code of the given contracts (in this order,
+	/// or concurrently where this does not change the result).
+	void optimiseAndAssemble(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Runs the optimiser on and assembles the code of a single contract.
+	void optimiseAndAssemble(ContractDefinition const& _contract);
+
+	/// @returns the key of the contract in the compilation cache, which is the hash of everything
+	/// that influences its compilation.
+	h256 cacheKey(Contract const& _contract) const;
+
+	/// Loads the compilation results of a single contract from the compilation cache.
+	/// @returns false if the cache is disabled or does not contain the contract.
+	bool loadFromCache(ContractDefinition const& _contract);
+
+	/// Stores the compilation results of a single contract in the compilation cache.
+	/// Has to be called after linking.
+	void storeInCache(ContractDefinition const& _contract) const;
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -359,6 +495,10 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const&) const;
 
+	/// @returns the profiler to activate for the phases run by this object, nullptr if
+	/// profiling is disabled.
+	Profiler* activeProfiler() const { return m_profiling ? &m_profiler : nullptr; }
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -371,6 +511,27 @@ private:
 	langutil::SVMVersion m_svmVersion;
 	std::set<std::string> m_requestedContractNames;
 	bool m_generateIR;
+	std::map<std::string, PipelineConfig> m_pipelineConfigs;
+	bool m_incrementalAnalysis = false;
+	RetainedAnalysis m_retainedAnalysis;
+	/// Owner of the sources the locations of the ASTs, the errors and the generated code refer to.
+	/// It is only replaced together with the retained analysis, since retained and superseded
+	/// ASTs still refer to sources that were replaced.
+	std::shared_ptr<langutil::SourceTable> m_sourceTable;
+	unsigned m_parallelism = 1;
+	/// Threads that parse, optimise and assemble, created once for the configured parallelism.
+	std::shared_ptr<ThreadPool> m_threadPool;
+	std::unique_ptr<CompilationCache> m_cache;
+	unsigned m_cacheHits = 0;
+	unsigned m_cacheMisses = 0;
+	bool m_profiling = false;
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
+	/// ABI and utility functions shared by the contracts of a compilation.
+	std::shared_ptr<YulFunctionRepository> m_yulFunctionRepository;
+	bool m_yulOptimiserStatisticsEnabled = false;
+	std::shared_ptr<yul::OptimiserStatistics> m_yulOptimiserStatistics;
+	/// Mutable because phases are also recorded by const accessors computing outputs lazily.
+	mutable Profiler m_profiler;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: octonion.institute/susy-go = /usr/local/sophon
 	/// "context:prefix=target"
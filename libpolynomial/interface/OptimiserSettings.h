@@ -22,10 +22,16 @@
 
 #pragma once
 
+#include <libyul/optimiser/Suite.h>
+
 #include <cstddef>
+#include <memory>
+#include <string>
 
 namespace dev
 {
+class ThreadPool;
+
 namespace polynomial
 {
 
@@ -80,6 +86,7 @@ struct OptimiserSettings
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
+			yulOptimiserSteps == _other.yulOptimiserSteps &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -101,6 +108,14 @@ struct OptimiserSettings
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
+	/// Sequence of steps run by the Yul optimiser, see yul::OptimiserSuite.
+	std::string yulOptimiserSteps = yul::OptimiserSuite::DefaultSequence;
+	/// Pool of threads the Yul optimiser optimises functions on concurrently, sequentially if unset.
+	/// It is created once by the owner of the settings and reused for every piece of Yul code.
+	/// This does not influence the result and is therefore not compared.
+	std::shared_ptr<ThreadPool> yulOptimiserThreadPool;
+	/// Receives statistics about the steps run by the Yul optimiser if set. Not compared either.
+	std::shared_ptr<yul::OptimiserStatistics> yulOptimiserStatistics;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
@@ -24,6 +24,9 @@
 
 #include <libpolynomial/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/OptimiserStatistics.h>
+#include <libyul/optimiser/Suite.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <libsvmasm/Instruction.h>
 #include <libdevcore/JSON.h>
@@ -190,22 +193,24 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 	return false;
 }
 
+/// Outputs that require the bytecode of a contract.
+/// This does not inculde "svm.methodIdentifiers" on purpose!
+vector<string> const g_outputsThatRequireBytecode{
+	"svm.deployedBytecode", "svm.deployedBytecode.object", "svm.deployedBytecode.opcodes",
+	"svm.deployedBytecode.sourceMap", "svm.deployedBytecode.linkReferences",
+	"svm.bytecode", "svm.bytecode.object", "svm.bytecode.opcodes", "svm.bytecode.sourceMap",
+	"svm.bytecode.linkReferences",
+	"svm.gasEstimates", "svm.legacyAssembly", "svm.assembly"
+};
+
 /// @returns true if any binary was requested, i.e. we actually have to perform compilation.
 bool isBinaryRequested(Json::Value const& _outputSelection)
 {
 	if (!_outputSelection.isObject())
 		return false;
 
-	// This does not inculde "svm.methodIdentifiers" on purpose!
-	static vector<string> const outputsThatRequireBinaries{
-		"*",
-		"ir", "irOptimized",
-		"svm.deployedBytecode", "svm.deployedBytecode.object", "svm.deployedBytecode.opcodes",
-		"svm.deployedBytecode.sourceMap", "svm.deployedBytecode.linkReferences",
-		"svm.bytecode", "svm.bytecode.object", "svm.bytecode.opcodes", "svm.bytecode.sourceMap",
-		"svm.bytecode.linkReferences",
-		"svm.gasEstimates", "svm.legacyAssembly", "svm.assembly"
-	};
+	static vector<string> const outputsThatRequireBinaries =
+		vector<string>{"*", "ir", "irOptimized"} + g_outputsThatRequireBytecode;
 
 	for (auto const& fileRequests: _outputSelection)
 		for (auto const& requests: fileRequests)
@@ -215,6 +220,15 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the compilation stages required for the outputs selected for the given contract.
+CompilerStack::PipelineConfig pipelineConfig(Json::Value const& _outputSelection, string const& _file, string const& _contract)
+{
+	CompilerStack::PipelineConfig config;
+	config.irCodegen = isArtifactRequested(_outputSelection, _file, _contract, vector<string>{"ir", "irOptimized"}, false);
+	config.bytecode = isArtifactRequested(_outputSelection, _file, _contract, g_outputsThatRequireBytecode, false);
+	return config;
+}
+
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
 /// yet match "ir" or "irOptimized"
 bool isIRRequested(Json::Value const& _outputSelection)
@@ -269,6 +283,68 @@ Json::Value collectSVMObject(sof::LinkerObject const& _object, string const* _so
 	return output;
 }
 
+Json::Value formatProfilingStatistics(Profiler::Statistics const& _statistics)
+{
+	Json::Value ret = Json::objectValue;
+	ret["time"] = double(_statistics.time.count()) / 1e6;
+	ret["calls"] = Json::UInt64(_statistics.calls);
+	ret["peakRSS"] = Json::UInt64(_statistics.peakRSS);
+	return ret;
+}
+
+Json::Value formatYulOptimiserStatistics(yul::OptimiserStatistics const& _statistics)
+{
+	Json::Value ret = Json::objectValue;
+	map<char, string> const stepNames = yul::OptimiserSuite::stepAbbreviationToNameMap();
+	ret["steps"] = Json::objectValue;
+	for (auto const& step: _statistics.totals())
+	{
+		Json::Value stepData = Json::objectValue;
+		stepData["abbreviation"] = string(1, step.first);
+		stepData["runs"] = Json::UInt64(step.second.runs);
+		stepData["time"] = double(step.second.time.count()) / 1e6;
+		stepData["nodesBefore"] = Json::UInt64(step.second.nodesBefore);
+		stepData["nodesAfter"] = Json::UInt64(step.second.nodesAfter);
+		stepData["codeSizeBefore"] = Json::UInt64(step.second.codeSizeBefore);
+		stepData["codeSizeAfter"] = Json::UInt64(step.second.codeSizeAfter);
+		ret["steps"][stepNames.at(step.first)] = stepData;
+	}
+	vector<yul::OptimiserStatistics::SuiteRun> const suiteRuns = _statistics.suiteRuns();
+	ret["optimizerRuns"] = Json::UInt64(suiteRuns.size());
+	ret["rounds"] = Json::arrayValue;
+	for (auto const& suiteRun: suiteRuns)
+		for (size_t rounds: suiteRun.rounds)
+			ret["rounds"].append(Json::UInt64(rounds));
+	ret["remarks"] = Json::arrayValue;
+	for (auto const& suiteRun: suiteRuns)
+		for (auto const& remark: suiteRun.remarks)
+		{
+			Json::Value remarkData = Json::objectValue;
+			remarkData["step"] = stepNames.at(remark.step);
+			remarkData["round"] = Json::UInt64(remark.round);
+			remarkData["message"] = remark.message;
+			ret["remarks"].append(remarkData);
+		}
+	return ret;
+}
+
+Json::Value formatProfilingStatistics(Profiler const& _profiler)
+{
+	Json::Value ret = Json::objectValue;
+	for (Profiler::Phase const& phase: _profiler.phases())
+	{
+		Json::Value phaseData = formatProfilingStatistics(phase.total);
+		if (!phase.contracts.empty())
+		{
+			phaseData["contracts"] = Json::objectValue;
+			for (auto const& contract: phase.contracts)
+				phaseData["contracts"][contract.first] = formatProfilingStatistics(contract.second);
+		}
+		ret[phase.name] = phaseData;
+	}
+	return ret;
+}
+
 boost::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> const& _keys, string const& _name)
 {
 	if (!!_input && !_input.isObject())
@@ -301,7 +377,7 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"svmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"cacheDirectory", "svmVersion", "libraries", "metadata", "optimizer", "outputSelection", "parallelism", "profiling", "remappings", "yulOptimizerStatistics"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -431,10 +507,29 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (details["yulDetails"].isMember("optimizerSteps"))
+			{
+				Json::Value const& steps = details["yulDetails"]["optimizerSteps"];
+				if (!steps.isString())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.optimizerSteps\" must be a string.");
+				try
+				{
+					yul::OptimiserSuite::validateSequence(steps.asString());
+				}
+				catch (yul::OptimizerException const& _exception)
+				{
+					return formatFatalError(
+						"JSONError",
+						"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": " +
+						*boost::get_error_info<errinfo_comment>(_exception)
+					);
+				}
+				settings.yulOptimiserSteps = steps.asString();
+			}
 		}
 	}
 	return { std::move(settings) };
@@ -608,6 +703,34 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 			ret.optimiserSettings = boost::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive number.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("cacheDirectory"))
+	{
+		if (!settings["cacheDirectory"].isString())
+			return formatFatalError("JSONError", "\"settings.cacheDirectory\" must be a string.");
+		ret.cacheDirectory = settings["cacheDirectory"].asString();
+	}
+
+	if (settings.isMember("profiling"))
+	{
+		if (!settings["profiling"].isBool())
+			return formatFatalError("JSONError", "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].asBool();
+	}
+
+	if (settings.isMember("yulOptimizerStatistics"))
+	{
+		if (!settings["yulOptimizerStatistics"].isBool())
+			return formatFatalError("JSONError", "\"settings.yulOptimizerStatistics\" must be a Boolean.");
+		ret.yulOptimizerStatistics = settings["yulOptimizerStatistics"].asBool();
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -679,6 +802,10 @@ Json::Value StandardCompiler::compilePolynomial(StandardCompiler::InputsAndSetti
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setCacheDirectory(_inputsAndSettings.cacheDirectory);
+	compilerStack.enableProfiling(_inputsAndSettings.profiling);
+	compilerStack.enableYulOptimiserStatistics(_inputsAndSettings.yulOptimizerStatistics);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 
 	bool const irRequested = isIRRequested(_inputsAndSettings.outputSelection);
@@ -691,10 +818,23 @@ Json::Value StandardCompiler::compilePolynomial(StandardCompiler::InputsAndSetti
 
 	try
 	{
-		if (binariesRequested)
+		if (compilerStack.parseAndAnalyze() && binariesRequested)
+		{
+			// Only run the stages needed for the outputs selected for each contract.
+			map<string, CompilerStack::PipelineConfig> pipelineConfigs;
+			for (string const& contractName: compilerStack.contractNames())
+			{
+				size_t colon = contractName.rfind(':');
+				polAssert(colon != string::npos, "");
+				pipelineConfigs[contractName] = pipelineConfig(
+					_inputsAndSettings.outputSelection,
+					contractName.substr(0, colon),
+					contractName.substr(colon + 1)
+				);
+			}
+			compilerStack.setPipelineConfigs(std::move(pipelineConfigs));
 			compilerStack.compile();
-		else
-			compilerStack.parseAndAnalyze();
+		}
 
 		for (auto const& error: compilerStack.errors())
 		{
@@ -883,6 +1023,17 @@ Json::Value StandardCompiler::compilePolynomial(StandardCompiler::InputsAndSetti
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (compilationSuccess && !_inputsAndSettings.cacheDirectory.empty())
+	{
+		output["cache"]["hits"] = compilerStack.cacheHits();
+		output["cache"]["misses"] = compilerStack.cacheMisses();
+	}
+
+	if (_inputsAndSettings.profiling)
+		output["profiling"] = formatProfilingStatistics(compilerStack.profiler());
+	if (auto yulOptimiserStatistics = compilerStack.yulOptimiserStatistics())
+		output["yulOptimizerStatistics"] = formatYulOptimiserStatistics(*yulOptimiserStatistics);
+
 	return output;
 }
 
@@ -900,6 +1051,9 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	Json::Value output = Json::objectValue;
 
+	shared_ptr<yul::OptimiserStatistics> optimiserStatistics;
+	if (_inputsAndSettings.yulOptimizerStatistics)
+		_inputsAndSettings.optimiserSettings.yulOptimiserStatistics = optimiserStatistics = make_shared<yul::OptimiserStatistics>();
 	AssemblyStack stack(
 		_inputsAndSettings.svmVersion,
 		AssemblyStack::Language::StrictAssembly,
@@ -958,6 +1112,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "svm.assembly", wildcardMatchesIR))
 		output["contracts"][sourceName][contractName]["svm"]["assembly"] = object.assembly;
+	if (optimiserStatistics)
+		output["yulOptimizerStatistics"] = formatYulOptimiserStatistics(*optimiserStatistics);
 
 	return output;
 }
@@ -67,6 +67,10 @@ private:
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
+		unsigned parallelism = 1;
+		std::string cacheDirectory;
+		bool profiling = false;
+		bool yulOptimizerStatistics = false;
 		Json::Value outputSelection;
 	};
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libpolynomial/ast/AST.h>
+#include <libpolynomial/ast/ASTArena.h>
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/SVMVersion.h>
 
@@ -49,9 +50,22 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// If disabled, the nodes of the parsed source units are allocated one by one instead of
+	/// in a common arena. Only meant for benchmarking.
+	void useArena(bool _useArena) { m_useArena = _useArena; }
+
 private:
 	class ASTNodeFactory;
 
+	/// Creates an object in the arena of the source unit that is being parsed.
+	template <class T, class... Args>
+	ASTPointer<T> createInArena(Args&&... _args) const
+	{
+		if (!m_arena)
+			return std::make_shared<T>(std::forward<Args>(_args)...);
+		return std::allocate_shared<T>(ASTArenaAllocator<T>(m_arena), std::forward<Args>(_args)...);
+	}
+
 	struct VarDeclParserOptions
 	{
 		// This is actually not needed, but due to a defect in the C++ standard, we have to.
@@ -189,6 +203,9 @@ private:
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
 	langutil::SVMVersion m_svmVersion;
+	bool m_useArena = true;
+	/// Memory of the nodes of the source unit that is being parsed.
+	std::shared_ptr<ASTArena> m_arena;
 };
 
 }
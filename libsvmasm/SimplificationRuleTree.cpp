@@ -0,0 +1,64 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Decision tree over the patterns of simplification rules.
+ */
+
+#include <libsvmasm/SimplificationRuleTree.h>
+
+#include <libsvmasm/Exceptions.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::sof;
+
+void SimplificationRuleTree::add(vector<Symbol> const& _pattern)
+{
+	assertThrow(!_pattern.empty(), OptimizerException, "Empty pattern.");
+
+	Node* node = &m_root;
+	// Number of symbols that still have to follow to complete the pattern.
+	size_t open = 1;
+	for (Symbol const& symbol: _pattern)
+	{
+		assertThrow(open > 0, OptimizerException, "Too many symbols in pattern.");
+		--open;
+		unique_ptr<Node>* child = nullptr;
+		switch (symbol.kind)
+		{
+		case Symbol::Kind::Any:
+			child = &node->any;
+			break;
+		case Symbol::Kind::Constant:
+			child = symbol.hasValue ? &node->constants[symbol.value] : &node->anyConstant;
+			break;
+		case Symbol::Kind::Operation:
+			child = &node->operations[symbol.instruction];
+			open += instructionInfo(symbol.instruction).args;
+			break;
+		case Symbol::Kind::OperationWithAnyArguments:
+			child = &node->operationsWithAnyArguments[symbol.instruction];
+			break;
+		}
+		if (!*child)
+			child->reset(new Node());
+		node = child->get();
+	}
+	assertThrow(open == 0, OptimizerException, "Pattern is missing arguments.");
+
+	node->rules.push_back(m_ruleCount++);
+}
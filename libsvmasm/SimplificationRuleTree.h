@@ -0,0 +1,183 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Decision tree over the patterns of simplification rules.
+ */
+
+#pragma once
+
+#include <libsvmasm/Instruction.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace sof
+{
+
+/**
+ * Discrimination tree that contains the patterns of a list of simplification rules and
+ * finds the rules whose patterns structurally match an expression in a single traversal
+ * of the expression, independent of the number of rules.
+ *
+ * Patterns are added as the sequence of their nodes in pre-order. The tree only checks
+ * instructions, constant values and the positions of wildcards, the consistency of match
+ * groups (e.g. ``sub(X, X)``) still has to be verified by matching the pattern of the
+ * candidate rules, which is a lot cheaper than trying every rule for the instruction.
+ *
+ * The tree is independent of the representation of expressions, which is accessed through
+ * an inspector (see match()), so that it can be used for assembly items and Yul alike.
+ */
+class SimplificationRuleTree: private boost::noncopyable
+{
+public:
+	struct Symbol
+	{
+		enum class Kind { Any, Constant, Operation, OperationWithAnyArguments };
+
+		/// Matches any expression.
+		static Symbol any() { return Symbol{Kind::Any, Instruction::STOP, false, {}}; }
+		/// Matches any constant.
+		static Symbol constant() { return Symbol{Kind::Constant, Instruction::STOP, false, {}}; }
+		/// Matches the constant @a _value.
+		static Symbol constant(u256 const& _value) { return Symbol{Kind::Constant, Instruction::STOP, true, _value}; }
+		/// Matches @a _instruction, followed by the symbols of its arguments.
+		static Symbol operation(Instruction _instruction) { return Symbol{Kind::Operation, _instruction, false, {}}; }
+		/// Matches @a _instruction with any arguments, not followed by further symbols.
+		static Symbol operationWithAnyArguments(Instruction _instruction)
+		{
+			return Symbol{Kind::OperationWithAnyArguments, _instruction, false, {}};
+		}
+
+		Kind kind;
+		Instruction instruction;
+		bool hasValue;
+		u256 value;
+	};
+
+	/// Adds the pattern of the next rule, i.e. the rule with index ruleCount().
+	/// @param _pattern the nodes of the pattern in pre-order.
+	void add(std::vector<Symbol> const& _pattern);
+
+	/// @returns the number of rules added so far.
+	size_t ruleCount() const { return m_ruleCount; }
+
+	/// Appends the indices of all rules whose patterns structurally match @a _expression
+	/// to @a _rules, in ascending order.
+	/// @param _inspector has to provide the following functions:
+	///  - ``Expression const& resolve(Expression const&)``: the expression to compare to a constant
+	///    or operation pattern node, e.g. the value of a variable. Wildcards match the unresolved expression.
+	///  - ``bool isConstant(Expression const&)``
+	///  - ``u256 value(Expression const&)``: only called for constants.
+	///  - ``bool isOperation(Expression const&, Instruction&)``: sets the instruction for operations.
+	///  - ``void appendArguments(Expression const&, std::vector<Expression const*>&)``: appends the
+	///    arguments of an operation in reverse order.
+	template <class Expression, class Inspector>
+	void match(Expression const& _expression, Inspector const& _inspector, std::vector<size_t>& _rules) const
+	{
+		size_t const begin = _rules.size();
+		std::vector<Expression const*> pending{&_expression};
+		match(m_root, pending, _inspector, _rules);
+		std::sort(_rules.begin() + begin, _rules.end());
+	}
+
+private:
+	struct Node
+	{
+		std::unique_ptr<Node> any;
+		std::unique_ptr<Node> anyConstant;
+		std::map<u256, std::unique_ptr<Node>> constants;
+		std::map<Instruction, std::unique_ptr<Node>> operations;
+		std::map<Instruction, std::unique_ptr<Node>> operationsWithAnyArguments;
+		/// Indices of the rules whose patterns end at this node.
+		std::vector<size_t> rules;
+	};
+
+	/// Matches the pending expressions (the next one at the back) against the subtree
+	/// rooted at @a _node. Leaves @a _pending unchanged.
+	template <class Expression, class Inspector>
+	static void match(
+		Node const& _node,
+		std::vector<Expression const*>& _pending,
+		Inspector const& _inspector,
+		std::vector<size_t>& _rules
+	)
+	{
+		if (_pending.empty())
+		{
+			_rules.insert(_rules.end(), _node.rules.begin(), _node.rules.end());
+			return;
+		}
+
+		Expression const* expression = _pending.back();
+		_pending.pop_back();
+
+		if (_node.any)
+			match(*_node.any, _pending, _inspector, _rules);
+
+		if (
+			_node.anyConstant ||
+			!_node.constants.empty() ||
+			!_node.operations.empty() ||
+			!_node.operationsWithAnyArguments.empty()
+		)
+		{
+			Expression const& resolved = _inspector.resolve(*expression);
+			Instruction instruction;
+			if (_inspector.isConstant(resolved))
+			{
+				if (_node.anyConstant)
+					match(*_node.anyConstant, _pending, _inspector, _rules);
+				if (!_node.constants.empty())
+				{
+					auto child = _node.constants.find(_inspector.value(resolved));
+					if (child != _node.constants.end())
+						match(*child->second, _pending, _inspector, _rules);
+				}
+			}
+			else if (_inspector.isOperation(resolved, instruction))
+			{
+				auto child = _node.operationsWithAnyArguments.find(instruction);
+				if (child != _node.operationsWithAnyArguments.end())
+					match(*child->second, _pending, _inspector, _rules);
+				child = _node.operations.find(instruction);
+				if (child != _node.operations.end())
+				{
+					size_t const pendingSize = _pending.size();
+					_inspector.appendArguments(resolved, _pending);
+					match(*child->second, _pending, _inspector, _rules);
+					_pending.resize(pendingSize);
+				}
+			}
+		}
+
+		_pending.push_back(expression);
+	}
+
+	Node m_root;
+	size_t m_ruleCount = 0;
+};
+
+}
+}
@@ -40,28 +40,63 @@ using namespace dev;
 using namespace dev::sof;
 using namespace langutil;
 
+namespace
+{
+
+/// Provides access to the equivalence classes of expressions for SimplificationRuleTree.
+class ExpressionInspector
+{
+public:
+	using Expression = ExpressionClasses::Expression;
+
+	explicit ExpressionInspector(ExpressionClasses const& _classes): m_classes(_classes) {}
+
+	Expression const& resolve(Expression const& _expr) const { return _expr; }
+	bool isConstant(Expression const& _expr) const { return _expr.item && _expr.item->type() == Push; }
+	u256 const& value(Expression const& _expr) const { return _expr.item->data(); }
+	bool isOperation(Expression const& _expr, Instruction& _instruction) const
+	{
+		if (!_expr.item || _expr.item->type() != Operation)
+			return false;
+		_instruction = _expr.item->instruction();
+		return true;
+	}
+	void appendArguments(Expression const& _expr, vector<Expression const*>& _pending) const
+	{
+		for (auto argument = _expr.arguments.rbegin(); argument != _expr.arguments.rend(); ++argument)
+			_pending.push_back(&m_classes.representative(*argument));
+	}
+
+private:
+	ExpressionClasses const& m_classes;
+};
+
+}
+
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
 )
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+
+	m_candidates.clear();
+	m_tree.match(_expr, ExpressionInspector(_classes), m_candidates);
+	for (size_t index: m_candidates)
 	{
+		auto const& rule = m_rules[index];
+		resetMatchGroups();
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
-
-		resetMatchGroups();
 	}
+	resetMatchGroups();
 	return nullptr;
 }
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -72,7 +107,11 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	assertThrow(_rule.pattern.type() == Operation, OptimizerException, "Rule does not match an operation.");
+	vector<SimplificationRuleTree::Symbol> symbols;
+	_rule.pattern.appendSymbols(symbols);
+	m_tree.add(symbols);
+	m_rules.push_back(_rule);
 }
 
 Rules::Rules()
@@ -134,6 +173,35 @@ AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 		return AssemblyItem(m_type, data(), _location);
 }
 
+void Pattern::appendSymbols(vector<SimplificationRuleTree::Symbol>& _symbols) const
+{
+	switch (m_type)
+	{
+	case UndefinedItem:
+		_symbols.push_back(SimplificationRuleTree::Symbol::any());
+		break;
+	case Push:
+		_symbols.push_back(
+			m_requireDataMatch ?
+			SimplificationRuleTree::Symbol::constant(data()) :
+			SimplificationRuleTree::Symbol::constant()
+		);
+		break;
+	case Operation:
+		// An operation without arguments in the pattern matches any arguments.
+		_symbols.push_back(
+			m_arguments.empty() && instructionInfo(m_instruction).args > 0 ?
+			SimplificationRuleTree::Symbol::operationWithAnyArguments(m_instruction) :
+			SimplificationRuleTree::Symbol::operation(m_instruction)
+		);
+		break;
+	default:
+		assertThrow(false, OptimizerException, "Unsupported pattern type.");
+	}
+	for (Pattern const& argument: m_arguments)
+		argument.appendSymbols(_symbols);
+}
+
 string Pattern::toString() const
 {
 	stringstream s;
@@ -25,6 +25,7 @@
 
 #include <libsvmasm/ExpressionClasses.h>
 #include <libsvmasm/SimplificationRule.h>
+#include <libsvmasm/SimplificationRuleTree.h>
 
 #include <boost/noncopyable.hpp>
 
@@ -73,7 +74,11 @@ private:
 	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	std::vector<SimplificationRule<Pattern>> m_rules;
+	/// Patterns of m_rules, used to find the candidates for a match.
+	SimplificationRuleTree m_tree;
+	/// Buffer for the indices of the candidate rules.
+	std::vector<size_t> m_candidates;
 };
 
 /**
@@ -103,6 +108,8 @@ public:
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
+	/// Appends the nodes of this pattern in pre-order to @a _symbols.
+	void appendSymbols(std::vector<SimplificationRuleTree::Symbol>& _symbols) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
@@ -61,9 +61,10 @@ shared_ptr<Block> Parser::parse(std::shared_ptr<Scanner> const& _scanner, bool _
 std::map<string, dev::sof::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::sof::Instruction> s_instructions;
-	if (s_instructions.empty())
+	// Initialised through a lambda, so that concurrent parsers can use it.
+	static map<string, dev::sof::Instruction> const s_instructions = []()
 	{
+		map<string, dev::sof::Instruction> instructions;
 		for (auto const& instruction: dev::sof::c_instructions)
 		{
 			if (
@@ -73,9 +74,10 @@ std::map<string, dev::sof::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			instructions[name] = instruction.second;
 		}
-	}
+		return instructions;
+	}();
 	return s_instructions;
 }
 
@@ -363,15 +365,16 @@ Expression Parser::parseExpression()
 
 std::map<dev::sof::Instruction, string> const& Parser::instructionNames()
 {
-	static map<dev::sof::Instruction, string> s_instructionNames;
-	if (s_instructionNames.empty())
+	static map<dev::sof::Instruction, string> const s_instructionNames = []()
 	{
+		map<dev::sof::Instruction, string> instructionNames;
 		for (auto const& instr: instructions())
-			s_instructionNames[instr.second] = instr.first;
+			instructionNames[instr.second] = instr.first;
 		// set the ambiguous instructions to a clear default
-		s_instructionNames[dev::sof::Instruction::SELFDESTRUCT] = "selfdestruct";
-		s_instructionNames[dev::sof::Instruction::KECCAK256] = "keccak256";
-	}
+		instructionNames[dev::sof::Instruction::SELFDESTRUCT] = "selfdestruct";
+		instructionNames[dev::sof::Instruction::KECCAK256] = "keccak256";
+		return instructionNames;
+	}();
 	return s_instructionNames;
 }
 
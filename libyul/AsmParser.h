@@ -69,10 +69,10 @@ protected:
 			r.location.end = endPosition();
 		}
 		if (!r.location.source)
-			r.location.source = m_scanner->charStream();
+			r.location.source = m_scanner->sourceReference();
 		return r;
 	}
-	langutil::SourceLocation location() const { return {position(), endPosition(), m_scanner->charStream()}; }
+	langutil::SourceLocation location() const { return {position(), endPosition(), m_scanner->sourceReference()}; }
 
 	Block parseBlock();
 	Statement parseStatement();
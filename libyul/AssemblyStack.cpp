@@ -79,6 +79,7 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	m_errors.clear();
 	m_analysisSuccessful = false;
 	m_scanner = make_shared<Scanner>(CharStream(_source, _sourceName));
+	m_sourceTable->add(m_scanner->charStream());
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_svmVersion)).parse(m_scanner, false);
 	if (!m_errorReporter.errors().empty())
 		return false;
@@ -153,7 +154,11 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		meter,
 		*_object.code,
 		*_object.analysisInfo,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		{},
+		m_optimiserSettings.yulOptimiserSteps,
+		m_optimiserSettings.yulOptimiserThreadPool.get(),
+		m_optimiserSettings.yulOptimiserStatistics.get()
 	);
 }
 
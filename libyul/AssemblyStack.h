@@ -23,6 +23,7 @@
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/SVMVersion.h>
+#include <liblangutil/SourceTable.h>
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
@@ -67,6 +68,7 @@ public:
 		m_language(_language),
 		m_svmVersion(_svmVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_sourceTable(std::make_shared<langutil::SourceTable>()),
 		m_errorReporter(m_errors)
 	{}
 
@@ -106,6 +108,8 @@ private:
 	dev::polynomial::OptimiserSettings m_optimiserSettings;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
+	/// Owner of the sources the locations of the parsed and optimised code refer to.
+	std::shared_ptr<langutil::SourceTable> m_sourceTable;
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
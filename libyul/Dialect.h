@@ -54,6 +54,10 @@ struct BuiltinFunction
 	/// If true, a call to this function can be omitted without changing semantics if the
 	/// program does not contain the msize instruction.
 	bool sideEffectFreeIfNoMSize = false;
+	/// If false, a call to this function does not modify storage.
+	bool invalidatesStorage = true;
+	/// If false, a call to this function does not modify memory.
+	bool invalidatesMemory = true;
 	/// If true, this is the msize instruction.
 	bool isMSize = false;
 	/// If true, can only accept literals as arguments and they cannot be moved to variables.
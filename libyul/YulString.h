@@ -24,6 +24,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,6 +36,8 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// Access to the repository is synchronized, so YulStrings can be created and
+/// resolved from multiple threads concurrently.
 class YulStringRepository
 {
 public:
@@ -55,6 +58,7 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
+		std::lock_guard<std::mutex> lock(m_mutex);
 		auto range = m_hashToID.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
 			if (*m_strings[it->second] == _string)
@@ -65,7 +69,13 @@ public:
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	std::string const& idToString(size_t _id) const
+	{
+		// The strings themselves are never moved, so the reference stays valid
+		// even if other threads add strings after the lock is released.
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return *m_strings.at(_id);
+	}
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -88,7 +98,7 @@ public:
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -103,9 +113,14 @@ public:
 private:
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_strings = {std::make_shared<std::string>()};
+		m_hashToID = {{emptyHash(), 0}};
+	}
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -115,6 +130,7 @@ private:
 
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	mutable std::mutex m_mutex;
 };
 
 /// Wrapper around handles into the YulString repository.
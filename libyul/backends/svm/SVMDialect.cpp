@@ -34,12 +34,18 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
 
 namespace
 {
+/// Guards the lazily created dialect instances, which are requested from concurrently running
+/// parsers and optimisers.
+mutex g_dialectsMutex;
+
 pair<YulString, BuiltinFunctionForSVM> createSVMFunction(
 	string const& _name,
 	dev::sof::Instruction _instruction
@@ -53,6 +59,8 @@ pair<YulString, BuiltinFunctionForSVM> createSVMFunction(
 	f.movable = sof::SemanticInformation::movable(_instruction);
 	f.sideEffectFree = sof::SemanticInformation::sideEffectFree(_instruction);
 	f.sideEffectFreeIfNoMSize = sof::SemanticInformation::sideEffectFreeIfNoMSize(_instruction);
+	f.invalidatesStorage = sof::SemanticInformation::invalidatesStorage(_instruction);
+	f.invalidatesMemory = sof::SemanticInformation::invalidatesMemory(_instruction);
 	f.isMSize = _instruction == dev::sof::Instruction::MSIZE;
 	f.literalArguments = false;
 	f.instruction = _instruction;
@@ -89,6 +97,9 @@ pair<YulString, BuiltinFunctionForSVM> createFunction(
 	f.literalArguments = _literalArguments;
 	f.sideEffectFree = _sideEffectFree;
 	f.sideEffectFreeIfNoMSize = _sideEffectFreeIfNoMSize;
+	// The object access functions do not write to storage and only datacopy writes to memory.
+	f.invalidatesStorage = false;
+	f.invalidatesMemory = !_sideEffectFree;
 	f.isMSize = false;
 	f.instruction = {};
 	f.generateCode = std::move(_generateCode);
@@ -186,6 +197,7 @@ BuiltinFunctionForSVM const* SVMDialect::builtin(YulString _name) const
 
 SVMDialect const& SVMDialect::looseAssemblyForSVM(langutil::SVMVersion _version)
 {
+	lock_guard<mutex> lock(g_dialectsMutex);
 	static map<langutil::SVMVersion, unique_ptr<SVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
 	if (!dialects[_version])
@@ -195,6 +207,7 @@ SVMDialect const& SVMDialect::looseAssemblyForSVM(langutil::SVMVersion _version)
 
 SVMDialect const& SVMDialect::strictAssemblyForSVM(langutil::SVMVersion _version)
 {
+	lock_guard<mutex> lock(g_dialectsMutex);
 	static map<langutil::SVMVersion, unique_ptr<SVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
 	if (!dialects[_version])
@@ -204,6 +217,7 @@ SVMDialect const& SVMDialect::strictAssemblyForSVM(langutil::SVMVersion _version
 
 SVMDialect const& SVMDialect::strictAssemblyForSVMObjects(langutil::SVMVersion _version)
 {
+	lock_guard<mutex> lock(g_dialectsMutex);
 	static map<langutil::SVMVersion, unique_ptr<SVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
 	if (!dialects[_version])
@@ -213,6 +227,7 @@ SVMDialect const& SVMDialect::strictAssemblyForSVMObjects(langutil::SVMVersion _
 
 SVMDialect const& SVMDialect::yulForSVM(langutil::SVMVersion _version)
 {
+	lock_guard<mutex> lock(g_dialectsMutex);
 	static map<langutil::SVMVersion, unique_ptr<SVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
 	if (!dialects[_version])
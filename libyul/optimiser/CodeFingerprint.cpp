@@ -0,0 +1,207 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that calculates a fingerprint of a piece of code.
+ */
+
+#include <libyul/optimiser/CodeFingerprint.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/// Tags that distinguish the kinds of nodes from each other.
+enum class Tag: uint64_t
+{
+	Literal = 1,
+	Identifier,
+	FunctionalInstruction,
+	FunctionCall,
+	ExpressionStatement,
+	Assignment,
+	VariableDeclaration,
+	If,
+	Switch,
+	Case,
+	Default,
+	FunctionDefinition,
+	ForLoop,
+	Break,
+	Continue,
+	Block
+};
+
+}
+
+CodeFingerprint::Fingerprint CodeFingerprint::run(Block const& _block)
+{
+	CodeFingerprint fingerprint;
+	fingerprint(_block);
+	return fingerprint.m_fingerprint;
+}
+
+void CodeFingerprint::operator()(Literal const& _literal)
+{
+	add(uint64_t(Tag::Literal));
+	add(_literal.location);
+	add(uint64_t(_literal.kind));
+	add(_literal.value);
+	add(_literal.type);
+}
+
+void CodeFingerprint::operator()(Identifier const& _identifier)
+{
+	add(uint64_t(Tag::Identifier));
+	add(_identifier.location);
+	add(_identifier.name);
+}
+
+void CodeFingerprint::operator()(FunctionalInstruction const& _instr)
+{
+	add(uint64_t(Tag::FunctionalInstruction));
+	add(_instr.location);
+	add(uint64_t(_instr.instruction));
+	add(_instr.arguments.size());
+	ASTWalker::operator()(_instr);
+}
+
+void CodeFingerprint::operator()(FunctionCall const& _funCall)
+{
+	add(uint64_t(Tag::FunctionCall));
+	add(_funCall.location);
+	(*this)(_funCall.functionName);
+	add(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void CodeFingerprint::operator()(ExpressionStatement const& _statement)
+{
+	add(uint64_t(Tag::ExpressionStatement));
+	add(_statement.location);
+	ASTWalker::operator()(_statement);
+}
+
+void CodeFingerprint::operator()(Assignment const& _assignment)
+{
+	add(uint64_t(Tag::Assignment));
+	add(_assignment.location);
+	add(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void CodeFingerprint::operator()(VariableDeclaration const& _varDecl)
+{
+	add(uint64_t(Tag::VariableDeclaration));
+	add(_varDecl.location);
+	add(_varDecl.variables);
+	add(uint64_t(!!_varDecl.value));
+	ASTWalker::operator()(_varDecl);
+}
+
+void CodeFingerprint::operator()(If const& _if)
+{
+	add(uint64_t(Tag::If));
+	add(_if.location);
+	ASTWalker::operator()(_if);
+}
+
+void CodeFingerprint::operator()(Switch const& _switch)
+{
+	add(uint64_t(Tag::Switch));
+	add(_switch.location);
+	visit(*_switch.expression);
+	add(_switch.cases.size());
+	for (auto const& _case: _switch.cases)
+	{
+		add(_case.location);
+		if (_case.value)
+		{
+			add(uint64_t(Tag::Case));
+			(*this)(*_case.value);
+		}
+		else
+			add(uint64_t(Tag::Default));
+		(*this)(_case.body);
+	}
+}
+
+void CodeFingerprint::operator()(FunctionDefinition const& _funDef)
+{
+	add(uint64_t(Tag::FunctionDefinition));
+	add(_funDef.location);
+	add(_funDef.name);
+	add(_funDef.parameters);
+	add(_funDef.returnVariables);
+	(*this)(_funDef.body);
+}
+
+void CodeFingerprint::operator()(ForLoop const& _loop)
+{
+	add(uint64_t(Tag::ForLoop));
+	add(_loop.location);
+	ASTWalker::operator()(_loop);
+}
+
+void CodeFingerprint::operator()(Break const& _break)
+{
+	add(uint64_t(Tag::Break));
+	add(_break.location);
+}
+
+void CodeFingerprint::operator()(Continue const& _continue)
+{
+	add(uint64_t(Tag::Continue));
+	add(_continue.location);
+}
+
+void CodeFingerprint::operator()(Block const& _block)
+{
+	add(uint64_t(Tag::Block));
+	add(_block.location);
+	add(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void CodeFingerprint::add(uint64_t _value)
+{
+	m_fingerprint.low = (m_fingerprint.low ^ _value) * 1099511628211u;
+	m_fingerprint.low ^= m_fingerprint.low >> 29;
+	m_fingerprint.high = (m_fingerprint.high + _value) * 11400714819323198485u;
+	m_fingerprint.high ^= m_fingerprint.high >> 31;
+}
+
+void CodeFingerprint::add(langutil::SourceLocation const& _location)
+{
+	add(uint64_t(reinterpret_cast<uintptr_t>(_location.source.get())));
+	add(uint64_t(uint32_t(_location.start)) | (uint64_t(uint32_t(_location.end)) << 32));
+}
+
+void CodeFingerprint::add(TypedNameList const& _names)
+{
+	add(_names.size());
+	for (auto const& name: _names)
+	{
+		add(name.location);
+		add(name.name);
+		add(name.type);
+	}
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that calculates a fingerprint of a piece of code.
+ */
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+
+namespace yul
+{
+
+/**
+ * Optimiser component that calculates a 128 bit fingerprint of a block.
+ *
+ * In contrast to BlockHasher, all names and source locations are taken into account,
+ * so blocks that are equal including their source locations have identical fingerprints
+ * and blocks with identical fingerprints are equal with overwhelming probability.
+ * This can be used to detect whether an optimiser step changed a piece of code.
+ *
+ * The fingerprint of a block is only meaningful during the lifetime of the source
+ * locations and strings it refers to.
+ */
+class CodeFingerprint: public ASTWalker
+{
+public:
+	struct Fingerprint
+	{
+		uint64_t low = 0;
+		uint64_t high = 0;
+
+		bool operator==(Fingerprint const& _other) const { return low == _other.low && high == _other.high; }
+		bool operator!=(Fingerprint const& _other) const { return !operator==(_other); }
+	};
+
+	static Fingerprint run(Block const& _block);
+
+	using ASTWalker::operator();
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionalInstruction const& _instr) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const& _break) override;
+	void operator()(Continue const& _continue) override;
+	void operator()(Block const& _block) override;
+
+private:
+	CodeFingerprint() = default;
+
+	/// Mixes @a _value into both halves of the fingerprint, which use
+	/// independent multipliers.
+	void add(uint64_t _value);
+	void add(YulString _name) { add(_name.hash()); add(_name.str().size()); }
+	void add(langutil::SourceLocation const& _location);
+	void add(TypedNameList const& _names);
+
+	Fingerprint m_fingerprint{14695981039346656037u, 9650029242287828579u};
+};
+
+}
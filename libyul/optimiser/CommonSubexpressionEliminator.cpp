@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/Exceptions.h>
@@ -69,16 +70,54 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 	}
 	else
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& var: m_value)
+		YulString replacement = findReplacement(_e);
+		if (!replacement.empty())
 		{
-			assertThrow(var.second, OptimizerException, "");
-			assertThrow(inScope(var.first), OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *var.second))
-			{
-				_e = Identifier{locationOf(_e), var.first};
-				break;
-			}
+			assertThrow(inScope(replacement), OptimizerException, "");
+			_e = Identifier{locationOf(_e), replacement};
 		}
 	}
 }
+
+void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
+{
+	// The values of the enclosing code are not visible inside the function.
+	decltype(m_candidates) candidates;
+	m_candidates.swap(candidates);
+	DataFlowAnalyzer::operator()(_fun);
+	m_candidates.swap(candidates);
+}
+
+void CommonSubexpressionEliminator::handleAssignment(set<YulString> const& _names, Expression* _value)
+{
+	DataFlowAnalyzer::handleAssignment(_names, _value);
+	for (auto const& name: _names)
+		if (Expression const* value = m_value[name])
+			m_candidates[ExpressionHasher::run(*value)].push_back(Candidate{name, value});
+}
+
+YulString CommonSubexpressionEliminator::findReplacement(Expression const& _expression)
+{
+	auto bucket = m_candidates.find(ExpressionHasher::run(_expression));
+	if (bucket == m_candidates.end())
+		return {};
+
+	YulString replacement;
+	vector<Candidate>& candidates = bucket->second;
+	for (auto candidate = candidates.begin(); candidate != candidates.end();)
+		// A variable never gets back a value it had before, so outdated entries can be removed.
+		if (m_value[candidate->variable] != candidate->value)
+			candidate = candidates.erase(candidate);
+		else
+		{
+			if (
+				(replacement.empty() || candidate->variable < replacement) &&
+				SyntacticallyEqual{}(_expression, *candidate->value)
+			)
+				replacement = candidate->variable;
+			++candidate;
+		}
+	if (candidates.empty())
+		m_candidates.erase(bucket);
+	return replacement;
+}
@@ -23,6 +23,9 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace yul
 {
 
@@ -32,6 +35,10 @@ struct Dialect;
  * Optimisation stage that replaces expressions known to be the current value of a variable
  * in scope by a reference to that variable.
  *
+ * The current values of the variables are kept in a table indexed by the hash of the
+ * value (see ExpressionHasher), so that the variables with a value equal to an expression
+ * are found without comparing the expression to every known value.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class CommonSubexpressionEliminator: public DataFlowAnalyzer
@@ -39,9 +46,30 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	CommonSubexpressionEliminator(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
 
+	using DataFlowAnalyzer::operator();
+	void operator()(FunctionDefinition&) override;
+
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void handleAssignment(std::set<YulString> const& _names, Expression* _value) override;
+
+private:
+	struct Candidate
+	{
+		YulString variable;
+		/// Value of the variable at the time it was added to the table. The entry is
+		/// outdated once the variable has a different value.
+		Expression const* value;
+	};
+
+	/// @returns the variable with a current value that is syntactically equal to @a _expression
+	/// and whose name comes first, or an empty string if there is none.
+	YulString findReplacement(Expression const& _expression);
+
+	/// Variables by hash of their value.
+	std::unordered_map<uint64_t, std::vector<Candidate>> m_candidates;
 };
 
 }
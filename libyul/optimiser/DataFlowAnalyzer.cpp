@@ -24,8 +24,10 @@
 
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
 
 #include <libdevcore/CommonData.h>
 
@@ -35,6 +37,41 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
+DataFlowAnalyzer::DataFlowAnalyzer(Dialect const& _dialect):
+	m_dialect(_dialect),
+	m_state(make_unique<State>())
+{
+}
+
+void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
+{
+	ASTModifier::operator()(_statement);
+
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _statement.expression);
+	if (
+		instruction &&
+		(instruction->first == dev::sof::Instruction::SSTORE || instruction->first == dev::sof::Instruction::MSTORE) &&
+		instruction->second->at(0).type() == typeid(Identifier) &&
+		instruction->second->at(1).type() == typeid(Identifier)
+	)
+	{
+		bool const isStorage = instruction->first == dev::sof::Instruction::SSTORE;
+		map<YulString, YulString>& contents = isStorage ? m_state->storage : m_state->memory;
+		YulString const location = boost::get<Identifier>(instruction->second->at(0)).name;
+		YulString const value = boost::get<Identifier>(instruction->second->at(1)).name;
+		// Only the contents at locations that do not overlap with the written word remain known.
+		u256 const distance = isStorage ? 1 : 32;
+		for (auto it = contents.begin(); it != contents.end();)
+			if (knownToDiffer(it->first, location, distance))
+				++it;
+			else
+				it = contents.erase(it);
+		contents[location] = value;
+	}
+	else
+		clearKnowledgeIfInvalidated(_statement.expression);
+}
+
 void DataFlowAnalyzer::operator()(Assignment& _assignment)
 {
 	set<YulString> names;
@@ -42,6 +79,7 @@ void DataFlowAnalyzer::operator()(Assignment& _assignment)
 		names.emplace(var.name);
 	assertThrow(_assignment.value, OptimizerException, "");
 	visit(*_assignment.value);
+	clearKnowledgeIfInvalidated(*_assignment.value);
 	handleAssignment(names, _assignment.value.get());
 }
 
@@ -53,46 +91,54 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 	m_variableScopes.back().variables += names;
 
 	if (_varDecl.value)
+	{
 		visit(*_varDecl.value);
+		clearKnowledgeIfInvalidated(*_varDecl.value);
+	}
 
 	handleAssignment(names, _varDecl.value.get());
 }
 
 void DataFlowAnalyzer::operator()(If& _if)
 {
-	ASTModifier::operator()(_if);
-
-	Assignments assignments;
-	assignments(_if.body);
-	clearValues(assignments.names());
+	visit(*_if.condition);
+	clearKnowledgeIfInvalidated(*_if.condition);
+	map<YulString, YulString> storage = m_state->storage;
+	map<YulString, YulString> memory = m_state->memory;
+	size_t assignedBefore = m_state->assigned.size();
+	(*this)(_if.body);
+	// What is known at the end of the body is only true if the body was executed.
+	m_state->storage = std::move(storage);
+	m_state->memory = std::move(memory);
+	clearKnowledgeIfInvalidated(_if.body);
+	joinBranch(assignedBefore);
 }
 
 void DataFlowAnalyzer::operator()(Switch& _switch)
 {
 	visit(*_switch.expression);
-	set<YulString> assignedVariables;
+	clearKnowledgeIfInvalidated(*_switch.expression);
+	map<YulString, YulString> const storage = m_state->storage;
+	map<YulString, YulString> const memory = m_state->memory;
 	for (auto& _case: _switch.cases)
 	{
+		size_t assignedBefore = m_state->assigned.size();
 		(*this)(_case.body);
-		Assignments assignments;
-		assignments(_case.body);
-		assignedVariables += assignments.names();
+		m_state->storage = storage;
+		m_state->memory = memory;
 		// This is a little too destructive, we could retain the old values.
-		clearValues(assignments.names());
+		joinBranch(assignedBefore);
 	}
-	clearValues(assignedVariables);
+	for (auto const& _case: _switch.cases)
+		clearKnowledgeIfInvalidated(_case.body);
 }
 
 void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 {
 	// Save all information. We might rather reinstantiate this class,
 	// but this could be difficult if it is subclassed.
-	map<YulString, Expression const*> value;
-	map<YulString, set<YulString>> references;
-	map<YulString, set<YulString>> referencedBy;
-	m_value.swap(value);
-	m_references.swap(references);
-	m_referencedBy.swap(referencedBy);
+	unique_ptr<State> state = make_unique<State>();
+	m_state.swap(state);
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -105,9 +151,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	ASTModifier::operator()(_fun);
 
 	popScope();
-	m_value.swap(value);
-	m_references.swap(references);
-	m_referencedBy.swap(referencedBy);
+	m_state.swap(state);
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -124,10 +168,19 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 	assignments(_for.post);
 	clearValues(assignments.names());
 
+	// The contents of storage and memory are only known in the loop if no iteration changes them.
+	clearKnowledgeIfInvalidated(*_for.condition);
+	clearKnowledgeIfInvalidated(_for.body);
+	clearKnowledgeIfInvalidated(_for.post);
+	map<YulString, YulString> storage = m_state->storage;
+	map<YulString, YulString> memory = m_state->memory;
+
 	visit(*_for.condition);
 	(*this)(_for.body);
 	clearValues(assignmentsSinceCont.names());
 	(*this)(_for.post);
+	m_state->storage = std::move(storage);
+	m_state->memory = std::move(memory);
 	clearValues(assignments.names());
 }
 
@@ -142,14 +195,19 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value)
 {
-	clearValues(_variables);
+	vector<size_t> variables;
+	for (auto const& name: _variables)
+		variables.push_back(index(name));
+	State& state = *m_state;
+	state.assigned += variables;
+	clearValues(variables);
 
 	MovableChecker movableChecker{m_dialect};
 	if (_value)
 		movableChecker.visit(*_value);
 	else
-		for (auto const& var: _variables)
-			m_value[var] = &m_zero;
+		for (size_t var: variables)
+			state.values[var] = &m_zero;
 
 	if (_value && _variables.size() == 1)
 	{
@@ -157,15 +215,17 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		// Expression has to be movable and cannot contain a reference
 		// to the variable that will be assigned to.
 		if (movableChecker.movable() && !movableChecker.referencedVariables().count(name))
-			m_value[name] = _value;
+			state.values[variables.front()] = _value;
 	}
 
-	auto const& referencedVariables = movableChecker.referencedVariables();
-	for (auto const& name: _variables)
+	vector<size_t> referencedVariables;
+	for (auto const& name: movableChecker.referencedVariables())
+		referencedVariables.push_back(index(name));
+	for (size_t var: variables)
 	{
-		m_references[name] = referencedVariables;
-		for (auto const& ref: referencedVariables)
-			m_referencedBy[ref].emplace(name);
+		state.references[var] = referencedVariables;
+		for (size_t ref: referencedVariables)
+			state.referencedBy[ref].push_back(var);
 	}
 }
 
@@ -181,6 +241,62 @@ void DataFlowAnalyzer::popScope()
 }
 
 void DataFlowAnalyzer::clearValues(set<YulString> _variables)
+{
+	vector<size_t> variables;
+	for (auto const& name: _variables)
+	{
+		size_t variable = findIndex(name);
+		if (variable != size_t(-1))
+			variables.push_back(variable);
+	}
+	clearValues(std::move(variables));
+}
+
+YulString DataFlowAnalyzer::storageValue(YulString _slot) const
+{
+	auto it = m_state->storage.find(_slot);
+	return it == m_state->storage.end() ? YulString{} : it->second;
+}
+
+YulString DataFlowAnalyzer::memoryValue(YulString _offset) const
+{
+	auto it = m_state->memory.find(_offset);
+	return it == m_state->memory.end() ? YulString{} : it->second;
+}
+
+bool DataFlowAnalyzer::inScope(YulString _variableName) const
+{
+	for (auto const& scope: m_variableScopes | boost::adaptors::reversed)
+	{
+		if (scope.variables.count(_variableName))
+			return true;
+		if (scope.isFunction)
+			return false;
+	}
+	return false;
+}
+
+size_t DataFlowAnalyzer::index(YulString _name)
+{
+	State& state = *m_state;
+	auto inserted = state.indices.emplace(_name, state.names.size());
+	if (inserted.second)
+	{
+		state.names.push_back(_name);
+		state.values.push_back(nullptr);
+		state.references.emplace_back();
+		state.referencedBy.emplace_back();
+	}
+	return inserted.first->second;
+}
+
+size_t DataFlowAnalyzer::findIndex(YulString _name) const
+{
+	auto it = m_state->indices.find(_name);
+	return it == m_state->indices.end() ? size_t(-1) : it->second;
+}
+
+void DataFlowAnalyzer::clearValues(vector<size_t> _variables)
 {
 	// All variables that reference variables to be cleared also have to be
 	// cleared, but not recursively, since only the value of the original
@@ -194,31 +310,127 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	//
 	// This cannot be easily tested since the substitutions will be done
 	// one by one on the fly, and the last line will just be add(1, 1)
+	State& state = *m_state;
 
 	// Clear variables that reference variables to be cleared.
-	for (auto const& name: _variables)
-		for (auto const& ref: m_referencedBy[name])
-			_variables.emplace(ref);
+	size_t const originalVariables = _variables.size();
+	for (size_t i = 0; i < originalVariables; ++i)
+		_variables += state.referencedBy[_variables[i]];
+	sort(_variables.begin(), _variables.end());
+	_variables.erase(unique(_variables.begin(), _variables.end()), _variables.end());
 
 	// Clear the value and update the reference relation.
-	for (auto const& name: _variables)
-		m_value.erase(name);
-	for (auto const& name: _variables)
+	for (size_t var: _variables)
+		state.values[var] = nullptr;
+	for (size_t var: _variables)
 	{
-		for (auto const& ref: m_references[name])
-			m_referencedBy[ref].erase(name);
-		m_references[name].clear();
+		for (size_t ref: state.references[var])
+		{
+			auto& referencedBy = state.referencedBy[ref];
+			referencedBy.erase(find(referencedBy.begin(), referencedBy.end(), var));
+		}
+		state.references[var].clear();
 	}
+
+	// Clear the known contents of storage and memory at or of the variables.
+	for (auto* contents: {&state.storage, &state.memory})
+		if (!contents->empty())
+			for (size_t var: _variables)
+			{
+				YulString const name = state.names[var];
+				contents->erase(name);
+				for (auto it = contents->begin(); it != contents->end();)
+					if (it->second == name)
+						it = contents->erase(it);
+					else
+						++it;
+			}
 }
 
-bool DataFlowAnalyzer::inScope(YulString _variableName) const
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
-	for (auto const& scope: m_variableScopes | boost::adaptors::reversed)
-	{
-		if (scope.variables.count(_variableName))
-			return true;
-		if (scope.isFunction)
-			return false;
-	}
-	return false;
+	if (m_state->storage.empty() && m_state->memory.empty())
+		return;
+	SideEffectsCollector sideEffects(m_dialect, _block);
+	if (sideEffects.invalidatesStorage())
+		m_state->storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_state->memory.clear();
+}
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expression)
+{
+	if (m_state->storage.empty() && m_state->memory.empty())
+		return;
+	SideEffectsCollector sideEffects(m_dialect, _expression);
+	if (sideEffects.invalidatesStorage())
+		m_state->storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_state->memory.clear();
+}
+
+bool DataFlowAnalyzer::knownToDiffer(YulString _a, YulString _b, u256 const& _distance) const
+{
+	Expression const* a = m_value[_a];
+	Expression const* b = m_value[_b];
+	if (
+		!a || a->type() != typeid(Literal) || boost::get<Literal>(*a).kind != LiteralKind::Number ||
+		!b || b->type() != typeid(Literal) || boost::get<Literal>(*b).kind != LiteralKind::Number
+	)
+		return false;
+	u256 const valueA = valueOfNumberLiteral(boost::get<Literal>(*a));
+	u256 const valueB = valueOfNumberLiteral(boost::get<Literal>(*b));
+	return (valueA > valueB ? valueA - valueB : valueB - valueA) >= _distance;
+}
+
+void DataFlowAnalyzer::joinBranch(size_t _assignedBefore)
+{
+	State& state = *m_state;
+	assertThrow(_assignedBefore <= state.assigned.size(), OptimizerException, "");
+	clearValues(vector<size_t>(state.assigned.begin() + _assignedBefore, state.assigned.end()));
+}
+
+pair<YulString, Expression const*> DataFlowAnalyzer::ValueMap::const_iterator::operator*() const
+{
+	return {m_position->first, m_map.m_analyzer.m_state->values[m_position->second]};
+}
+
+void DataFlowAnalyzer::ValueMap::const_iterator::skipUnknown()
+{
+	State const& state = *m_map.m_analyzer.m_state;
+	while (m_position != state.indices.end() && !state.values[m_position->second])
+		++m_position;
+}
+
+Expression const* DataFlowAnalyzer::ValueMap::at(YulString _name) const
+{
+	Expression const* value = (*this)[_name];
+	assertThrow(value, OptimizerException, "Unknown value of variable " + _name.str() + ".");
+	return value;
+}
+
+Expression const* DataFlowAnalyzer::ValueMap::operator[](YulString _name) const
+{
+	size_t variable = m_analyzer.findIndex(_name);
+	return variable == size_t(-1) ? nullptr : m_analyzer.m_state->values[variable];
+}
+
+DataFlowAnalyzer::ValueMap::const_iterator DataFlowAnalyzer::ValueMap::begin() const
+{
+	return const_iterator(*this, m_analyzer.m_state->indices.begin());
+}
+
+DataFlowAnalyzer::ValueMap::const_iterator DataFlowAnalyzer::ValueMap::end() const
+{
+	return const_iterator(*this, m_analyzer.m_state->indices.end());
+}
+
+set<YulString> DataFlowAnalyzer::ReferenceMap::operator[](YulString _name) const
+{
+	set<YulString> references;
+	size_t variable = m_analyzer.findIndex(_name);
+	if (variable != size_t(-1))
+		for (size_t ref: m_analyzer.m_state->references[variable])
+			references.insert(m_analyzer.m_state->names[ref]);
+	return references;
 }
@@ -27,7 +27,10 @@
 #include <libyul/AsmData.h>
 
 #include <map>
+#include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace yul
 {
@@ -40,14 +43,27 @@ struct Dialect;
  *
  * A special zero constant expression is used for the default value of variables.
  *
+ * The analyzer also tracks the contents of storage and memory that are known after
+ * ``sstore(a, b)`` and ``mstore(a, b)`` with variables ``a`` and ``b``. This knowledge is
+ * cleared if one of the variables is re-assigned or if storage or memory might be modified
+ * at a location that is not known to be different, which includes any call to a function
+ * that is not a builtin.
+ *
+ * The variables of each function are mapped to dense indices on first use, so that
+ * values and references are stored in flat vectors. Instead of collecting the variables
+ * assigned to inside of branches in a separate walk, the indices of assigned variables
+ * are recorded in a journal and the values of the variables recorded since the start
+ * of a branch are cleared where control flow is merged again.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class DataFlowAnalyzer: public ASTModifier
 {
 public:
-	explicit DataFlowAnalyzer(Dialect const& _dialect): m_dialect(_dialect) {}
+	explicit DataFlowAnalyzer(Dialect const& _dialect);
 
 	using ASTModifier::operator();
+	void operator()(ExpressionStatement& _statement) override;
 	void operator()(Assignment& _assignment) override;
 	void operator()(VariableDeclaration& _varDecl) override;
 	void operator()(If& _if) override;
@@ -57,8 +73,9 @@ public:
 	void operator()(Block& _block) override;
 
 protected:
-	/// Registers the assignment.
-	void handleAssignment(std::set<YulString> const& _names, Expression* _value);
+	/// Registers the assignment. Derived classes can override this to observe all
+	/// assignments, including the implicit ones to return variables and uninitialized variables.
+	virtual void handleAssignment(std::set<YulString> const& _names, Expression* _value);
 
 	/// Creates a new inner scope.
 	void pushScope(bool _functionScope);
@@ -73,12 +90,68 @@ protected:
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
 
+	/// @returns the variable that is known to hold the value stored at the storage slot
+	/// given by the variable @a _slot, or an empty string if it is not known.
+	YulString storageValue(YulString _slot) const;
+	/// @returns the variable that is known to hold the value stored in memory at the offset
+	/// given by the variable @a _offset, or an empty string if it is not known.
+	YulString memoryValue(YulString _offset) const;
+
+	/**
+	 * Read-only view of the current values of the variables of the current function,
+	 * behaving like a map that only contains the variables with known value.
+	 */
+	class ValueMap
+	{
+	public:
+		class const_iterator
+		{
+		public:
+			using Position = std::map<YulString, size_t>::const_iterator;
+			const_iterator(ValueMap const& _map, Position _position): m_map(_map), m_position(_position) { skipUnknown(); }
+			std::pair<YulString, Expression const*> operator*() const;
+			const_iterator& operator++() { ++m_position; skipUnknown(); return *this; }
+			bool operator!=(const_iterator const& _other) const { return m_position != _other.m_position; }
+		private:
+			void skipUnknown();
+			ValueMap const& m_map;
+			Position m_position;
+		};
+
+		explicit ValueMap(DataFlowAnalyzer const& _analyzer): m_analyzer(_analyzer) {}
+
+		size_t count(YulString _name) const { return (*this)[_name] ? 1 : 0; }
+		/// @returns the value of the variable, throws if it is not known.
+		Expression const* at(YulString _name) const;
+		/// @returns the value of the variable or nullptr if it is not known.
+		Expression const* operator[](YulString _name) const;
+
+		const_iterator begin() const;
+		const_iterator end() const;
+
+	private:
+		DataFlowAnalyzer const& m_analyzer;
+	};
+
+	/**
+	 * Read-only view of the variables referenced by the current values of the variables
+	 * of the current function.
+	 */
+	class ReferenceMap
+	{
+	public:
+		explicit ReferenceMap(DataFlowAnalyzer const& _analyzer): m_analyzer(_analyzer) {}
+		/// @returns the variables referenced by the current value of @a _name.
+		std::set<YulString> operator[](YulString _name) const;
+
+	private:
+		DataFlowAnalyzer const& m_analyzer;
+	};
+
 	/// Current values of variables, always movable.
-	std::map<YulString, Expression const*> m_value;
+	ValueMap const m_value{*this};
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
-	std::map<YulString, std::set<YulString>> m_references;
-	/// m_referencedBy[b].contains(a) <=> the current expression assigned to a references b
-	std::map<YulString, std::set<YulString>> m_referencedBy;
+	ReferenceMap const m_references{*this};
 
 	struct Scope
 	{
@@ -92,6 +165,50 @@ protected:
 	/// List of scopes.
 	std::vector<Scope> m_variableScopes;
 	Dialect const& m_dialect;
+
+private:
+	/// Data flow information about the variables of one function, indexed by variable.
+	struct State
+	{
+		/// Index of each variable, also determines the order of iteration of m_value.
+		std::map<YulString, size_t> indices;
+		std::vector<YulString> names;
+		/// Current value of each variable or nullptr if unknown.
+		std::vector<Expression const*> values;
+		/// references[a] contains b <=> the current expression assigned to a references b
+		std::vector<std::vector<size_t>> references;
+		/// referencedBy[b] contains a <=> the current expression assigned to a references b
+		std::vector<std::vector<size_t>> referencedBy;
+		/// Variables in the order they were assigned to.
+		std::vector<size_t> assigned;
+		/// storage[a] = b <=> the storage slot given by the value of a holds the value of b
+		std::map<YulString, YulString> storage;
+		/// memory[a] = b <=> the memory word at the offset given by the value of a holds the value of b
+		std::map<YulString, YulString> memory;
+	};
+
+	/// @returns the index of the variable in the current function, assigning a new one if needed.
+	size_t index(YulString _name);
+	/// @returns the index of the variable in the current function or -1 if it was not used so far.
+	size_t findIndex(YulString _name) const;
+
+	/// Clears the values of the given variables and of all variables referencing them
+	/// as well as the known contents of storage and memory referring to them.
+	void clearValues(std::vector<size_t> _variables);
+
+	/// Clears the known contents of storage and memory if the code might modify them.
+	void clearKnowledgeIfInvalidated(Block const& _block);
+	void clearKnowledgeIfInvalidated(Expression const& _expression);
+
+	/// @returns true if the values of both variables are known to be constants that differ
+	/// by at least @a _distance.
+	bool knownToDiffer(YulString _a, YulString _b, dev::u256 const& _distance) const;
+
+	/// Clears the values of all variables assigned to since @a _assignedBefore was the size
+	/// of the assignment journal, i.e. since the start of a branch.
+	void joinBranch(size_t _assignedBefore);
+
+	std::unique_ptr<State> m_state;
 };
 
 }
@@ -34,7 +34,8 @@ using namespace yul;
 void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
-	while (auto match = SimplificationRules::findFirstMatch(_expression, m_dialect, m_value))
+	function<Expression const*(YulString)> const values = [this](YulString _name) { return m_value[_name]; };
+	while (auto match = SimplificationRules::findFirstMatch(_expression, m_dialect, values))
 	{
 		// Do not apply the rule if it removes non-constant parts of the expression.
 		// TODO: The check could actually be less strict than "movable".
@@ -38,8 +38,17 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser):
-	m_ast(_ast), m_nameDispenser(_dispenser)
+size_t constexpr FullInliner::DefaultRuns;
+size_t constexpr FullInliner::LoopIterations;
+size_t constexpr FullInliner::MaxLoopDepth;
+
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	GasMeter const& _meter,
+	vector<string>* _remarks
+):
+	m_ast(_ast), m_nameDispenser(_dispenser), m_meter(_meter), m_remarks(_remarks)
 {
 	// Determine constants
 	SSAValueTracker tracker;
@@ -57,6 +66,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser):
 			continue;
 		FunctionDefinition& fun = boost::get<FunctionDefinition>(statement);
 		m_functions[fun.name] = &fun;
+		m_calls[fun.name] = references[fun.name];
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
@@ -79,7 +89,7 @@ void FullInliner::run()
 	}
 }
 
-bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
+bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite, size_t _loopDepth)
 {
 	// No recursive inlining
 	if (_funCall.functionName.name == _callSite)
@@ -92,17 +102,25 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 	if (recursive(*calledFunction))
 		return false;
 
+	YulString const name = calledFunction->name;
+
 	// Inline really, really tiny functions
-	size_t size = m_functionSizes.at(calledFunction->name);
+	size_t size = m_functionSizes.at(name);
 	if (size <= 1)
-		return true;
+		return decide(true, name, _callSite, "the function is tiny");
 
 	// Do not inline into already big functions.
-	if (m_functionSizes.at(_callSite) > 45)
-		return false;
-
-	if (m_singleUse.count(calledFunction->name))
-		return true;
+	if (m_functionSizes.at(_callSite) > maxCallSiteSize())
+		return decide(
+			false,
+			name,
+			_callSite,
+			"the caller is too large (size " + to_string(m_functionSizes.at(_callSite)) +
+			", limit " + to_string(maxCallSiteSize()) + ")"
+		);
+
+	if (m_singleUse.count(name))
+		return decide(true, name, _callSite, "the function is only called once");
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
 	bool constantArg = false;
@@ -116,7 +134,42 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
-	return (size < 6 || (constantArg && size < 12));
+	if (size < 6 || (constantArg && size < 12))
+		return decide(
+			true,
+			name,
+			_callSite,
+			string("the function is small") + (constantArg ? " and called with a constant argument" : "")
+		);
+
+	// Larger functions are only inlined if the code runs more often than by default and only
+	// the additional runs are counted, so the decisions for the default number of runs do not change.
+	if (m_meter.runs() <= DefaultRuns)
+		return decide(false, name, _callSite, "the function is too large (size " + to_string(size) + ")");
+
+	size_t executions = 1;
+	for (size_t depth = 0; depth < min(_loopDepth, MaxLoopDepth); ++depth)
+		executions *= LoopIterations;
+	// The arguments are evaluated in both cases, so only the call itself is saved.
+	size_t const savings =
+		m_meter.runtimeCosts(Expression{FunctionCall{_funCall.location, _funCall.functionName, {}}}) *
+		executions *
+		(m_meter.runs() - DefaultRuns);
+	// The function itself can be removed once it is inlined at all of its calls, so every call
+	// accounts for all but one copy of the body.
+	size_t const calls = max<size_t>(m_calls.at(name), 1);
+	size_t const deploymentCosts = m_meter.costs(calledFunction->body, 0) * (calls - 1) / calls;
+
+	return decide(
+		savings > deploymentCosts,
+		name,
+		_callSite,
+		"savings of the call " + to_string(savings) +
+		(savings > deploymentCosts ? " exceed" : " do not exceed") +
+		" deployment costs " + to_string(deploymentCosts) +
+		" (estimated executions per run: " + to_string(executions) + ", runs: " + to_string(m_meter.runs()) +
+		", calls: " + to_string(calls) + ")"
+	);
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
@@ -140,6 +193,26 @@ bool FullInliner::recursive(FunctionDefinition const& _fun) const
 	return references[_fun.name] > 0;
 }
 
+size_t FullInliner::maxCallSiteSize() const
+{
+	// 45 for the default number of runs, plus 45 for every further factor of ten.
+	size_t limit = 45;
+	for (size_t runs = m_meter.runs(); runs >= 10 * DefaultRuns; runs /= 10)
+		limit += 45;
+	return limit;
+}
+
+bool FullInliner::decide(bool _inline, YulString _function, YulString _callSite, string const& _reason)
+{
+	if (m_remarks)
+		m_remarks->emplace_back(
+			string(_inline ? "Inlined " : "Did not inline ") + _function.str() +
+			" into " + (_callSite.empty() ? string("the main code") : _callSite.str()) +
+			": " + _reason + "."
+		);
+	return _inline;
+}
+
 void InlineModifier::operator()(Block& _block)
 {
 	function<boost::optional<vector<Statement>>(Statement&)> f = [&](Statement& _statement) -> boost::optional<vector<Statement>> {
@@ -149,6 +222,17 @@ void InlineModifier::operator()(Block& _block)
 	iterateReplacing(_block.statements, f);
 }
 
+void InlineModifier::operator()(ForLoop& _loop)
+{
+	// The init part is only executed once.
+	(*this)(_loop.pre);
+	++m_loopDepth;
+	visit(*_loop.condition);
+	(*this)(_loop.post);
+	(*this)(_loop.body);
+	--m_loopDepth;
+}
+
 boost::optional<vector<Statement>> InlineModifier::tryInlineStatement(Statement& _statement)
 {
 	// Only inline for expression statements, assignments and variable declarations.
@@ -163,7 +247,7 @@ boost::optional<vector<Statement>> InlineModifier::tryInlineStatement(Statement&
 		FunctionCall* funCall = boost::apply_visitor(GenericFallbackReturnsVisitor<FunctionCall*, FunctionCall&>(
 			[](FunctionCall& _e) { return &_e; }
 		), *e);
-		if (funCall && m_driver.shallInline(*funCall, m_currentFunction))
+		if (funCall && m_driver.shallInline(*funCall, m_currentFunction, m_loopDepth))
 			return performInline(_statement, *funCall);
 	}
 	return {};
@@ -32,10 +32,13 @@
 #include <boost/optional.hpp>
 
 #include <set>
+#include <string>
+#include <vector>
 
 namespace yul
 {
 
+class GasMeter;
 class NameCollector;
 
 
@@ -63,19 +66,39 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * Tiny functions and functions that are only called once are always inlined,
+ * other functions are only inlined if the function containing the call is not
+ * too large. Small functions are inlined, where constant arguments allow slightly
+ * larger functions. If the code is expected to run more often than by default,
+ * the gas meter weighs the costs of the call for the additional runs against the
+ * costs of deploying a copy of the body of the function for larger functions. The
+ * number of executions of a call per run is estimated from the number of for loops
+ * the call is nested in. The function can be removed once all of its calls are
+ * inlined, so each of n calls only accounts for (n - 1) / n copies of the body.
+ * The limit for the size of the function containing the call grows with the
+ * expected number of runs.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
 class FullInliner: public ASTModifier
 {
 public:
-	explicit FullInliner(Block& _ast, NameDispenser& _dispenser);
+	/// @param _remarks if not null, receives an explanation of every decision about a call
+	/// to a function that is not recursive.
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		GasMeter const& _meter,
+		std::vector<std::string>* _remarks = nullptr
+	);
 
 	void run();
 
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
-	bool shallInline(FunctionCall const& _funCall, YulString _callSite);
+	/// @param _loopDepth the number of for loops the function call is nested in.
+	bool shallInline(FunctionCall const& _funCall, YulString _callSite, size_t _loopDepth);
 
 	FunctionDefinition* function(YulString _name)
 	{
@@ -91,9 +114,21 @@ public:
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
 private:
+	/// Number of runs the size limits are tuned for, only additional runs make inlining more aggressive.
+	static size_t constexpr DefaultRuns = 200;
+	/// Estimated number of iterations of a for loop.
+	static size_t constexpr LoopIterations = 10;
+	/// Loops nested deeper than this do not increase the estimated number of executions.
+	static size_t constexpr MaxLoopDepth = 3;
+
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
 	bool recursive(FunctionDefinition const& _fun) const;
+	/// @returns the size up to which functions are inlined into.
+	size_t maxCallSiteSize() const;
+	/// Records the decision about inlining @a _function into @a _callSite, if remarks are requested.
+	/// @returns @a _inline.
+	bool decide(bool _inline, YulString _function, YulString _callSite, std::string const& _reason);
 
 	/// The AST to be modified. The root block itself will not be modified, because
 	/// we store pointers to functions.
@@ -104,7 +139,11 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Number of references to each function before inlining.
+	std::map<YulString, size_t> m_calls;
 	NameDispenser& m_nameDispenser;
+	GasMeter const& m_meter;
+	std::vector<std::string>* m_remarks = nullptr;
 };
 
 /**
@@ -121,12 +160,15 @@ public:
 	{ }
 
 	void operator()(Block& _block) override;
+	void operator()(ForLoop& _loop) override;
 
 private:
 	boost::optional<std::vector<Statement>> tryInlineStatement(Statement& _statement);
 	std::vector<Statement> performInline(Statement& _statement, FunctionCall& _funCall);
 
 	YulString m_currentFunction;
+	/// Number of for loops the current statement is nested in.
+	size_t m_loopDepth = 0;
 	FullInliner& m_driver;
 	NameDispenser& m_nameDispenser;
 };
@@ -0,0 +1,253 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that specialises functions for constant arguments.
+ */
+
+#include <libyul/optimiser/FunctionSpecializer.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+size_t constexpr FunctionSpecializer::MinCallSites;
+
+namespace
+{
+
+/// Collects all function calls.
+class FunctionCallCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		calls.emplace_back(&_funCall);
+	}
+
+	vector<FunctionCall const*> calls;
+};
+
+}
+
+void FunctionSpecializer::run(
+	Dialect const& _dialect,
+	GasMeter const& _meter,
+	Block& _ast,
+	NameDispenser& _nameDispenser
+)
+{
+	FunctionSpecializer specializer{_dialect, _meter, _ast, _nameDispenser};
+	specializer.specialize();
+	if (!specializer.m_specializations.empty())
+		specializer(_ast);
+}
+
+FunctionSpecializer::FunctionSpecializer(
+	Dialect const& _dialect,
+	GasMeter const& _meter,
+	Block& _ast,
+	NameDispenser& _nameDispenser
+):
+	m_dialect(_dialect),
+	m_meter(_meter),
+	m_ast(_ast),
+	m_nameDispenser(_nameDispenser),
+	m_references(ReferencesCounter::countReferences(_ast))
+{
+	SSAValueTracker tracker;
+	tracker(_ast);
+	for (auto const& ssaValue: tracker.values())
+		if (ssaValue.second && ssaValue.second->type() == typeid(Literal))
+			m_constants.emplace(ssaValue.first, boost::get<Literal>(*ssaValue.second));
+
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& function = boost::get<FunctionDefinition>(statement);
+			m_functions[function.name] = &function;
+		}
+
+	FunctionCallCollector collector;
+	collector(_ast);
+	for (FunctionCall const* call: collector.calls)
+		if (m_functions.count(call->functionName.name))
+			for (size_t i = 0; i < call->arguments.size(); ++i)
+				if (Literal const* value = constantValue(call->arguments[i]))
+				{
+					Candidate& candidate = m_candidates[call->functionName.name][i][valueOfNumberLiteral(*value)];
+					if (candidate.callSites == 0)
+						candidate.value = *value;
+					++candidate.callSites;
+				}
+}
+
+void FunctionSpecializer::operator()(FunctionCall& _funCall)
+{
+	ASTModifier::operator()(_funCall);
+
+	auto specialization = m_specializations.find(_funCall.functionName.name);
+	if (specialization == m_specializations.end())
+		return;
+	size_t const parameter = specialization->second.first;
+	if (Literal const* value = constantValue(_funCall.arguments.at(parameter)))
+	{
+		auto copy = specialization->second.second.find(valueOfNumberLiteral(*value));
+		if (copy != specialization->second.second.end())
+		{
+			_funCall.functionName.name = copy->second;
+			_funCall.arguments.erase(_funCall.arguments.begin() + ptrdiff_t(parameter));
+		}
+	}
+}
+
+void FunctionSpecializer::specialize()
+{
+	vector<Statement> newFunctions;
+	for (auto const& function: m_candidates)
+	{
+		FunctionDefinition const& original = *m_functions.at(function.first);
+
+		size_t bestSavings = 0;
+		size_t bestParameter = 0;
+		vector<pair<u256, FunctionDefinition>> bestCopies;
+		for (auto const& parameter: function.second)
+		{
+			size_t savings = 0;
+			vector<pair<u256, FunctionDefinition>> copies;
+			for (auto const& constant: parameter.second)
+			{
+				Candidate const& candidate = constant.second;
+				if (candidate.callSites < MinCallSites)
+					continue;
+				FunctionDefinition copy = specializedCopy(original, parameter.first, candidate.value);
+				// Before: The body is run on every call, and every call site pushes the constant.
+				// After: Only the specialised body is run, but the original function
+				// still has to be deployed if it is called from elsewhere.
+				size_t const costsBefore =
+					m_meter.costs(original.body, candidate.callSites) +
+					candidate.callSites * m_meter.costs(Expression{candidate.value});
+				size_t const costsAfter =
+					m_meter.costs(copy.body, candidate.callSites) +
+					(candidate.callSites < m_references.at(function.first) ? m_meter.costs(original.body, 0) : 0);
+				if (costsAfter < costsBefore)
+				{
+					savings += costsBefore - costsAfter;
+					copies.emplace_back(constant.first, std::move(copy));
+				}
+			}
+			if (savings > bestSavings)
+			{
+				bestSavings = savings;
+				bestParameter = parameter.first;
+				bestCopies = std::move(copies);
+			}
+		}
+		if (bestCopies.empty())
+			continue;
+
+		auto& specialization = m_specializations[function.first];
+		specialization.first = bestParameter;
+		for (auto& copy: bestCopies)
+		{
+			FunctionDefinition& specialized = copy.second;
+			map<YulString, YulString> replacements;
+			for (auto const& variable: specialized.parameters + specialized.returnVariables)
+				replacements[variable.name] = m_nameDispenser.newName(variable.name);
+			FunctionDefinition renamed{
+				specialized.location,
+				m_nameDispenser.newName(function.first),
+				specialized.parameters,
+				specialized.returnVariables,
+				boost::get<Block>(BodyCopier{m_nameDispenser, replacements}(specialized.body))
+			};
+			for (auto& variable: renamed.parameters)
+				variable.name = replacements.at(variable.name);
+			for (auto& variable: renamed.returnVariables)
+				variable.name = replacements.at(variable.name);
+			specialization.second[copy.first] = renamed.name;
+			newFunctions.emplace_back(std::move(renamed));
+		}
+	}
+	// Only added now because m_functions points into the AST.
+	m_functions.clear();
+	m_ast.statements += std::move(newFunctions);
+}
+
+Literal const* FunctionSpecializer::constantValue(Expression const& _argument) const
+{
+	Literal const* value = nullptr;
+	if (_argument.type() == typeid(Literal))
+		value = &boost::get<Literal>(_argument);
+	else if (_argument.type() == typeid(Identifier))
+	{
+		auto constant = m_constants.find(boost::get<Identifier>(_argument).name);
+		if (constant != m_constants.end())
+			value = &constant->second;
+	}
+	if (value && value->kind == LiteralKind::Number)
+		return value;
+	return nullptr;
+}
+
+FunctionDefinition FunctionSpecializer::specializedCopy(
+	FunctionDefinition const& _function,
+	size_t _parameter,
+	Literal const& _value
+) const
+{
+	Block unit{_function.location, {}};
+	unit.statements.emplace_back(ASTCopier{}(_function));
+	FunctionDefinition& copy = boost::get<FunctionDefinition>(unit.statements.front());
+
+	TypedName const parameter = copy.parameters.at(_parameter);
+	copy.parameters.erase(copy.parameters.begin() + ptrdiff_t(_parameter));
+	copy.body.statements.insert(
+		copy.body.statements.begin(),
+		VariableDeclaration{_value.location, {parameter}, make_unique<Expression>(_value)}
+	);
+
+	// Fold the constant and remove the branches that become unreachable. The second
+	// round simplifies the code that depended on the removed branches.
+	for (size_t round = 0; round < 2; ++round)
+	{
+		ExpressionSimplifier::run(m_dialect, unit);
+		StructuralSimplifier{m_dialect}(unit);
+		BlockFlattener{}(unit);
+		DeadCodeEliminator{m_dialect}(unit);
+		UnusedPruner::run(m_dialect, copy, false);
+	}
+	return std::move(copy);
+}
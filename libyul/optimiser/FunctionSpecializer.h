@@ -0,0 +1,109 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that specialises functions for constant arguments.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmData.h>
+
+#include <libdevcore/Common.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+class GasMeter;
+class NameDispenser;
+
+/**
+ * Optimisation stage that creates copies of functions that are specialised for a
+ * constant value of one of their parameters.
+ *
+ * If a function is called with the same literal (or a variable that is never
+ * re-assigned and has a literal value) for a parameter at least twice, a copy of
+ * the function is created that does not have this parameter but declares it as
+ * a variable with the constant value instead. The copy is simplified by the
+ * expression simplifier and the structural simplifier, which can fold expressions
+ * and remove branches that depend on the parameter, and the copy is only kept if
+ * it is cheaper according to the gas meter than calling the original function,
+ * taking the expected number of runs into account. In that case, the calls with
+ * the constant are replaced by calls to the copy.
+ *
+ * Per function, all constants of a single parameter are specialised in one run,
+ * namely the parameter for which the savings are the largest.
+ *
+ * The original function is kept, the unused pruner removes it if it is not
+ * called anymore.
+ *
+ * Prerequisites: Disambiguator, ForLoopInitRewriter, FunctionHoister, FunctionGrouper
+ */
+class FunctionSpecializer: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, GasMeter const& _meter, Block& _ast, NameDispenser& _nameDispenser);
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _funCall) override;
+
+private:
+	FunctionSpecializer(Dialect const& _dialect, GasMeter const& _meter, Block& _ast, NameDispenser& _nameDispenser);
+
+	/// Minimal number of calls with the same constant for a parameter.
+	static size_t constexpr MinCallSites = 2;
+
+	struct Candidate
+	{
+		/// Literal of the constant, the first one found for its value.
+		Literal value;
+		size_t callSites = 0;
+	};
+
+	/// Determines the specialisations and adds the specialised functions to the AST.
+	void specialize();
+	/// @returns the literal value of the argument, if it is constant, and nullptr otherwise.
+	Literal const* constantValue(Expression const& _argument) const;
+	/// @returns a copy of the function without the parameter at @a _parameter, which is
+	/// declared as a variable with the value @a _value instead, after simplification.
+	/// The copy keeps the names of the function and its variables.
+	FunctionDefinition specializedCopy(
+		FunctionDefinition const& _function,
+		size_t _parameter,
+		Literal const& _value
+	) const;
+
+	Dialect const& m_dialect;
+	GasMeter const& m_meter;
+	Block& m_ast;
+	NameDispenser& m_nameDispenser;
+	/// Variables that are never re-assigned and have a literal value.
+	std::map<YulString, Literal> m_constants;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Number of references to each function.
+	std::map<YulString, size_t> m_references;
+	/// Calls with constant arguments by function, parameter index and value.
+	std::map<YulString, std::map<size_t, std::map<dev::u256, Candidate>>> m_candidates;
+	/// The specialised parameter and the names of the specialised copies by value, per function.
+	std::map<YulString, std::pair<size_t, std::map<dev::u256, YulString>>> m_specializations;
+};
+
+}
@@ -0,0 +1,56 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces loads from storage and memory by the values
+ * that are known to be stored there.
+ */
+
+#include <libyul/optimiser/LoadResolver.h>
+
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoadResolver::run(Dialect const& _dialect, Block& _ast)
+{
+	LoadResolver{_dialect}(_ast);
+}
+
+void LoadResolver::visit(Expression& _e)
+{
+	DataFlowAnalyzer::visit(_e);
+
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _e);
+	if (
+		!instruction ||
+		(instruction->first != dev::sof::Instruction::SLOAD && instruction->first != dev::sof::Instruction::MLOAD) ||
+		instruction->second->at(0).type() != typeid(Identifier)
+	)
+		return;
+
+	YulString const location = boost::get<Identifier>(instruction->second->at(0)).name;
+	YulString const value =
+		instruction->first == dev::sof::Instruction::SLOAD ?
+		storageValue(location) :
+		memoryValue(location);
+	if (!value.empty() && inScope(value))
+		_e = Identifier{locationOf(_e), value};
+}
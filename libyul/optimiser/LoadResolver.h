@@ -0,0 +1,52 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces loads from storage and memory by the values
+ * that are known to be stored there.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+
+namespace yul
+{
+
+/**
+ * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)``
+ * by the variable that holds the value currently stored in storage resp. memory at ``x``,
+ * if it is known, i.e. after ``sstore(x, v)`` resp. ``mstore(x, v)`` without intervening
+ * modifications (see DataFlowAnalyzer).
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoadResolver: public DataFlowAnalyzer
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+private:
+	explicit LoadResolver(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+
+protected:
+	using ASTModifier::visit;
+	void visit(Expression& _e) override;
+};
+
+}
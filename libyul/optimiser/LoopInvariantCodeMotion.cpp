@@ -0,0 +1,113 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations out of for loops.
+ */
+
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoopInvariantCodeMotion::run(Dialect const& _dialect, Block& _ast)
+{
+	set<YulString> ssaVariables = NameCollector{_ast}.names();
+	Assignments assignments;
+	assignments(_ast);
+	for (YulString name: assignments.names())
+		ssaVariables.erase(name);
+	LoopInvariantCodeMotion{_dialect, std::move(ssaVariables)}(_ast);
+}
+
+void LoopInvariantCodeMotion::operator()(Block& _block)
+{
+	iterateReplacing(
+		_block.statements,
+		[&](Statement& _s) -> boost::optional<vector<Statement>>
+		{
+			visit(_s);
+			if (_s.type() == typeid(ForLoop))
+				return rewriteLoop(boost::get<ForLoop>(_s));
+			else
+				return {};
+		}
+	);
+}
+
+bool LoopInvariantCodeMotion::canBePromoted(
+	VariableDeclaration const& _varDecl,
+	set<YulString> const& _varsDefinedInCurrentScope
+) const
+{
+	// Literals, including the implicit zero of a declaration without value,
+	// are as cheap to push inside the loop as to keep on the stack and moving
+	// them only makes the variable live for the whole loop.
+	if (!_varDecl.value || _varDecl.value->type() == typeid(Literal))
+		return false;
+	for (auto const& var: _varDecl.variables)
+		if (!m_ssaVariables.count(var.name))
+			return false;
+	MovableChecker checker{m_dialect, *_varDecl.value};
+	if (!checker.movable())
+		return false;
+	for (YulString ref: checker.referencedVariables())
+		if (_varsDefinedInCurrentScope.count(ref) || !m_ssaVariables.count(ref))
+			return false;
+	return true;
+}
+
+boost::optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
+{
+	assertThrow(_for.pre.statements.empty(), OptimizerException, "ForLoopInitRewriter needs to be run first.");
+	vector<Statement> replacement;
+	for (Block* block: {&_for.post, &_for.body})
+	{
+		set<YulString> varsDefinedInScope;
+		iterateReplacing(
+			block->statements,
+			[&](Statement& _s) -> boost::optional<vector<Statement>>
+			{
+				if (_s.type() == typeid(VariableDeclaration))
+				{
+					VariableDeclaration const& varDecl = boost::get<VariableDeclaration>(_s);
+					if (canBePromoted(varDecl, varsDefinedInScope))
+					{
+						replacement.emplace_back(std::move(_s));
+						// The moved variables are not added to varsDefinedInScope,
+						// so that declarations depending on them can be moved as well.
+						return vector<Statement>{};
+					}
+					for (auto const& var: varDecl.variables)
+						varsDefinedInScope.insert(var.name);
+				}
+				return {};
+			}
+		);
+	}
+	if (replacement.empty())
+		return {};
+	replacement.emplace_back(std::move(_for));
+	return {std::move(replacement)};
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations out of for loops.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <boost/optional.hpp>
+
+#include <set>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+
+/**
+ * Loop-invariant code motion.
+ *
+ * This optimization moves movable SSA variable declarations outside the loop.
+ *
+ * Only statements at the top level in a loop's body or post block are considered, i.e variable
+ * declarations inside conditional branches will not be moved out of the loop.
+ *
+ * A variable declaration is moved in front of the loop if
+ *  - all variables it declares are never re-assigned (SSA),
+ *  - its value is not a literal, since that would only increase the stack pressure,
+ *  - its value is movable (see Semantics.h) and
+ *  - its value only references SSA variables that are not declared inside the loop
+ *    by a declaration that is not moved.
+ *
+ * Since loops are processed from the inside out, invariant declarations can move
+ * across several levels of nested loops.
+ *
+ * Requirements:
+ * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
+ * - Expression splitter and SSA transform should be run upfront to obtain better results.
+ */
+class LoopInvariantCodeMotion: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	explicit LoopInvariantCodeMotion(Dialect const& _dialect, std::set<YulString> _ssaVariables):
+		m_dialect(_dialect),
+		m_ssaVariables(std::move(_ssaVariables))
+	{}
+
+	/// @returns true if the variable declaration can be moved in front of the loop.
+	bool canBePromoted(VariableDeclaration const& _varDecl, std::set<YulString> const& _varsDefinedInCurrentScope) const;
+	/// Moves the invariant declarations out of the loop. @returns the moved declarations
+	/// followed by the loop or nothing if no declaration can be moved.
+	boost::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
+
+	Dialect const& m_dialect;
+	std::set<YulString> const m_ssaVariables;
+};
+
+}
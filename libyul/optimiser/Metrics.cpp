@@ -96,6 +96,26 @@ void CodeSize::visit(Expression const& _expression)
 }
 
 
+size_t NodeCount::nodeCount(Block const& _block)
+{
+	NodeCount counter;
+	counter(_block);
+	return counter.m_count;
+}
+
+void NodeCount::visit(Statement const& _statement)
+{
+	++m_count;
+	ASTWalker::visit(_statement);
+}
+
+void NodeCount::visit(Expression const& _expression)
+{
+	++m_count;
+	ASTWalker::visit(_expression);
+}
+
+
 size_t CodeCost::codeCost(Dialect const& _dialect, Expression const& _expr)
 {
 	CodeCost cc(_dialect);
@@ -174,11 +194,23 @@ size_t GasMeter::costs(Expression const& _expression) const
 	return combineCosts(GasMeterVisitor::costs(_expression, m_dialect, m_isCreation));
 }
 
+size_t GasMeter::runtimeCosts(Expression const& _expression) const
+{
+	return GasMeterVisitor::costs(_expression, m_dialect, m_isCreation).first;
+}
+
 size_t GasMeter::instructionCosts(sof::Instruction _instruction) const
 {
 	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
 }
 
+size_t GasMeter::costs(Block const& _block, size_t _executions) const
+{
+	pair<size_t, size_t> costs = GasMeterVisitor::costs(_block, m_dialect, m_isCreation);
+	costs.first *= _executions;
+	return combineCosts(costs);
+}
+
 size_t GasMeter::combineCosts(std::pair<size_t, size_t> _costs) const
 {
 	return _costs.first * m_runs + _costs.second;
@@ -196,6 +228,17 @@ pair<size_t, size_t> GasMeterVisitor::costs(
 	return {gmv.m_runGas, gmv.m_dataGas};
 }
 
+pair<size_t, size_t> GasMeterVisitor::costs(
+	Block const& _block,
+	SVMDialect const& _dialect,
+	bool _isCreation
+)
+{
+	GasMeterVisitor gmv(_dialect, _isCreation);
+	gmv(_block);
+	return {gmv.m_runGas, gmv.m_dataGas};
+}
+
 pair<size_t, size_t> GasMeterVisitor::instructionCosts(
 	dev::sof::Instruction _instruction,
 	SVMDialect const& _dialect,
@@ -209,14 +252,18 @@ pair<size_t, size_t> GasMeterVisitor::instructionCosts(
 
 void GasMeterVisitor::operator()(FunctionCall const& _funCall)
 {
-	ASTWalker::operator()(_funCall);
-	if (BuiltinFunctionForSVM const* f = m_dialect.builtin(_funCall.functionName.name))
-		if (f->instruction)
-		{
-			instructionCostsInternal(*f->instruction);
-			return;
-		}
-	yulAssert(false, "Functions not implemented.");
+	BuiltinFunctionForSVM const* f = m_dialect.builtin(_funCall.functionName.name);
+	if (!f || !f->literalArguments)
+		ASTWalker::operator()(_funCall);
+	if (f)
+		// Builtins without instruction (e.g. datasize) are counted like a push.
+		instructionCostsInternal(f->instruction ? *f->instruction : sof::Instruction::PUSH1);
+	else
+		// Push the return label and the function label, jump to the function and back.
+		instructionCostsInternal({
+			sof::Instruction::PUSH1, sof::Instruction::PUSH1, sof::Instruction::JUMP,
+			sof::Instruction::JUMPDEST, sof::Instruction::JUMP, sof::Instruction::JUMPDEST
+		});
 }
 
 void GasMeterVisitor::operator()(FunctionalInstruction const& _fun)
@@ -239,6 +286,45 @@ void GasMeterVisitor::operator()(Identifier const&)
 	m_dataGas += singleByteDataGas();
 }
 
+void GasMeterVisitor::operator()(If const& _if)
+{
+	ASTWalker::operator()(_if);
+	instructionCostsInternal({
+		sof::Instruction::ISZERO, sof::Instruction::PUSH1, sof::Instruction::JUMPI, sof::Instruction::JUMPDEST
+	});
+}
+
+void GasMeterVisitor::operator()(Switch const& _switch)
+{
+	ASTWalker::operator()(_switch);
+	for (auto const& _case: _switch.cases)
+		if (_case.value)
+			instructionCostsInternal({
+				sof::Instruction::DUP1, sof::Instruction::EQ, sof::Instruction::PUSH1,
+				sof::Instruction::JUMPI, sof::Instruction::JUMPDEST
+			});
+	instructionCostsInternal({sof::Instruction::POP});
+}
+
+void GasMeterVisitor::operator()(ForLoop const& _loop)
+{
+	ASTWalker::operator()(_loop);
+	instructionCostsInternal({
+		sof::Instruction::JUMPDEST, sof::Instruction::ISZERO, sof::Instruction::PUSH1, sof::Instruction::JUMPI,
+		sof::Instruction::JUMPDEST, sof::Instruction::PUSH1, sof::Instruction::JUMP, sof::Instruction::JUMPDEST
+	});
+}
+
+void GasMeterVisitor::operator()(Break const&)
+{
+	instructionCostsInternal({sof::Instruction::PUSH1, sof::Instruction::JUMP});
+}
+
+void GasMeterVisitor::operator()(Continue const&)
+{
+	instructionCostsInternal({sof::Instruction::PUSH1, sof::Instruction::JUMP});
+}
+
 size_t GasMeterVisitor::singleByteDataGas() const
 {
 	if (m_isCreation)
@@ -249,13 +335,57 @@ size_t GasMeterVisitor::singleByteDataGas() const
 
 void GasMeterVisitor::instructionCostsInternal(dev::sof::Instruction _instruction)
 {
-	if (_instruction == sof::Instruction::EXP)
+	// Instructions whose costs depend on their arguments or the state are counted with
+	// their minimal costs.
+	switch (_instruction)
+	{
+	case sof::Instruction::EXP:
 		m_runGas += dev::sof::GasCosts::expGas + dev::sof::GasCosts::expByteGas(m_dialect.svmVersion());
-	else
+		break;
+	case sof::Instruction::KECCAK256:
+		m_runGas += dev::sof::GasCosts::keccak256Gas;
+		break;
+	case sof::Instruction::SLOAD:
+		m_runGas += dev::sof::GasCosts::sloadGas(m_dialect.svmVersion());
+		break;
+	case sof::Instruction::SSTORE:
+		m_runGas += dev::sof::GasCosts::sstoreResetGas;
+		break;
+	case sof::Instruction::LOG0:
+	case sof::Instruction::LOG1:
+	case sof::Instruction::LOG2:
+	case sof::Instruction::LOG3:
+	case sof::Instruction::LOG4:
+		m_runGas +=
+			dev::sof::GasCosts::logGas +
+			dev::sof::GasCosts::logTopicGas * dev::sof::getLogNumber(_instruction);
+		break;
+	case sof::Instruction::CREATE:
+	case sof::Instruction::CREATE2:
+		m_runGas += dev::sof::GasCosts::createGas;
+		break;
+	case sof::Instruction::CALL:
+	case sof::Instruction::CALLCODE:
+	case sof::Instruction::DELEGATECALL:
+	case sof::Instruction::STATICCALL:
+		m_runGas += dev::sof::GasCosts::callGas(m_dialect.svmVersion());
+		break;
+	case sof::Instruction::SELFDESTRUCT:
+		m_runGas += dev::sof::GasCosts::selfdestructGas(m_dialect.svmVersion());
+		break;
+	default:
 		m_runGas += dev::sof::GasMeter::runGas(_instruction);
+		break;
+	}
 	m_dataGas += singleByteDataGas();
 }
 
+void GasMeterVisitor::instructionCostsInternal(initializer_list<sof::Instruction> _instructions)
+{
+	for (sof::Instruction instruction: _instructions)
+		instructionCostsInternal(instruction);
+}
+
 void AssignmentCounter::operator()(Assignment const& _assignment)
 {
 	for (auto const& variable: _assignment.variableNames)
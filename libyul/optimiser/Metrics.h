@@ -26,6 +26,8 @@
 
 #include <libsvmasm/Instruction.h>
 
+#include <initializer_list>
+
 namespace yul
 {
 
@@ -69,6 +71,22 @@ private:
 	size_t m_size = 0;
 };
 
+/**
+ * Number of statements and expressions, including the ones inside of functions.
+ * In contrast to CodeSize, every node counts as one.
+ */
+class NodeCount: public ASTWalker
+{
+public:
+	static size_t nodeCount(Block const& _block);
+
+private:
+	void visit(Statement const& _statement) override;
+	void visit(Expression const& _expression) override;
+
+	size_t m_count = 0;
+};
+
 /**
  * Very rough cost that takes the size and execution cost of code into account.
  * The cost per AST element is one, except for literals where it is the byte size.
@@ -100,6 +118,11 @@ private:
  * Gas meter for expressions only involving literals, identifiers and
  * SVM instructions.
  *
+ * Blocks of code can also be measured, where control flow and calls to
+ * functions that are not builtins are only taken into account with the costs
+ * of their jumps (see GasMeterVisitor). Such a measurement is only a rough
+ * estimate that allows to compare different versions of the same code.
+ *
  * Assumes that EXP is not used with exponents larger than a single byte.
  * Is not particularly exact for anything apart from arithmetic.
  */
@@ -114,9 +137,16 @@ public:
 
 	/// @returns the full combined costs of deploying and evaluating the expression.
 	size_t costs(Expression const& _expression) const;
+	/// @returns the gas for evaluating the expression once, without the costs of deploying it.
+	size_t runtimeCosts(Expression const& _expression) const;
 	/// @returns the combined costs of deploying and running the instruction, not including
 	/// the costs for its arguments.
 	size_t instructionCosts(dev::sof::Instruction _instruction) const;
+	/// @returns the combined costs of deploying the code once and running it
+	/// @a _executions times per run. Function definitions inside the block are ignored.
+	size_t costs(Block const& _block, size_t _executions = 1) const;
+
+	size_t runs() const { return m_runs; }
 
 private:
 	size_t combineCosts(std::pair<size_t, size_t> _costs) const;
@@ -126,6 +156,14 @@ private:
 	size_t m_runs;
 };
 
+/**
+ * Computes the run gas and the data gas of code.
+ *
+ * Calls to functions that are not builtins are counted with the costs of the
+ * jumps to the function and back, not including the body of the function.
+ * Control flow statements are counted with the costs of their jumps, as if
+ * every statement was executed exactly once.
+ */
 class GasMeterVisitor: public ASTWalker
 {
 public:
@@ -135,6 +173,12 @@ public:
 		bool _isCreation
 	);
 
+	static std::pair<size_t, size_t> costs(
+		Block const& _block,
+		SVMDialect const& _dialect,
+		bool _isCreation
+	);
+
 	static std::pair<size_t, size_t> instructionCosts(
 		dev::sof::Instruction _instruction,
 		SVMDialect const& _dialect,
@@ -147,13 +191,22 @@ public:
 		m_isCreation{_isCreation}
 	{}
 
+	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
 	void operator()(FunctionalInstruction const& _instr) override;
 	void operator()(Literal const& _literal) override;
 	void operator()(Identifier const& _identifier) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
 
 private:
 	size_t singleByteDataGas() const;
+	/// Adds the costs of the given instructions (excluding their arguments).
+	void instructionCostsInternal(std::initializer_list<dev::sof::Instruction> _instructions);
 	/// Computes the cost of storing and executing the single instruction (excluding its arguments).
 	/// For EXP, it assumes that the exponent is at most 255.
 	/// Does not work particularly exact for anything apart from arithmetic.
@@ -0,0 +1,60 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Statistics about the runs of the optimiser suite.
+ */
+
+#include <libyul/optimiser/OptimiserStatistics.h>
+
+using namespace std;
+using namespace yul;
+
+void OptimiserStatistics::add(SuiteRun _run)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_suiteRuns.emplace_back(std::move(_run));
+}
+
+void OptimiserStatistics::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_suiteRuns.clear();
+}
+
+vector<OptimiserStatistics::SuiteRun> OptimiserStatistics::suiteRuns() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_suiteRuns;
+}
+
+map<char, OptimiserStatistics::StepTotals> OptimiserStatistics::totals() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	map<char, StepTotals> result;
+	for (SuiteRun const& suiteRun: m_suiteRuns)
+		for (StepRun const& stepRun: suiteRun.steps)
+		{
+			StepTotals& totals = result[stepRun.step];
+			totals.runs++;
+			totals.time += stepRun.time;
+			totals.nodesBefore += stepRun.nodesBefore;
+			totals.nodesAfter += stepRun.nodesAfter;
+			totals.codeSizeBefore += stepRun.codeSizeBefore;
+			totals.codeSizeAfter += stepRun.codeSizeAfter;
+		}
+	return result;
+}
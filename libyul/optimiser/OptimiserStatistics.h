@@ -0,0 +1,100 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Statistics about the runs of the optimiser suite.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace yul
+{
+
+/**
+ * Statistics about the runs of the optimiser suite it is passed to, i.e. the time every
+ * application of a step took and how it changed the code. Recording is thread-safe.
+ */
+class OptimiserStatistics
+{
+public:
+	/// One application of a step to the code.
+	struct StepRun
+	{
+		/// Abbreviation of the step, see OptimiserSuite::stepAbbreviationToNameMap.
+		char step = 0;
+		/// Round of the repeated part of the sequence the step was applied in, counting from one,
+		/// or zero outside of brackets.
+		size_t round = 0;
+		std::chrono::nanoseconds time{0};
+		/// Number of statements and expressions, including the ones inside of functions.
+		size_t nodesBefore = 0;
+		size_t nodesAfter = 0;
+		/// See CodeSize::codeSizeIncludingFunctions.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+
+	/// Explanation of a decision a step made, e.g. about inlining a function call.
+	struct Remark
+	{
+		/// Abbreviation of the step that made the decision.
+		char step = 0;
+		/// See StepRun::round.
+		size_t round = 0;
+		std::string message;
+	};
+
+	/// One run of the optimiser suite.
+	struct SuiteRun
+	{
+		std::vector<StepRun> steps;
+		/// Number of rounds each part of the sequence in brackets was repeated for.
+		std::vector<size_t> rounds;
+		/// Remarks of the steps in the order they were made in.
+		std::vector<Remark> remarks;
+	};
+
+	/// Accumulated applications of a step.
+	struct StepTotals
+	{
+		size_t runs = 0;
+		std::chrono::nanoseconds time{0};
+		size_t nodesBefore = 0;
+		size_t nodesAfter = 0;
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+
+	void add(SuiteRun _run);
+	void clear();
+
+	/// @returns the recorded runs of the suite in the order they were recorded in.
+	std::vector<SuiteRun> suiteRuns() const;
+	/// @returns the accumulated applications of every step that was applied, by abbreviation.
+	std::map<char, StepTotals> totals() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector<SuiteRun> m_suiteRuns;
+};
+
+}
@@ -54,6 +54,8 @@ public:
 	}
 	bool sideEffectFreeIfNoMSize() const { return m_sideEffectFreeIfNoMSize; }
 	bool containsMSize() const { return m_containsMSize; }
+	bool invalidatesStorage() const { return m_invalidatesStorage; }
+	bool invalidatesMemory() const { return m_invalidatesMemory; }
 
 private:
 	Dialect const& m_dialect;
@@ -69,6 +71,12 @@ private:
 	/// Note that this is a purely syntactic property meaning that even if this is false,
 	/// the code can still contain calls to functions that contain the msize instruction.
 	bool m_containsMSize = false;
+	/// If false, storage is guaranteed to be unchanged by the code under all
+	/// circumstances.
+	bool m_invalidatesStorage = false;
+	/// If false, memory is guaranteed to be unchanged by the code under all
+	/// circumstances.
+	bool m_invalidatesMemory = false;
 };
 
 /**
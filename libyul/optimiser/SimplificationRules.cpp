@@ -35,22 +35,78 @@ using namespace dev::sof;
 using namespace langutil;
 using namespace yul;
 
+namespace
+{
+
+/// Provides access to Yul expressions for SimplificationRuleTree, resolving variables
+/// the same way Pattern::matches does.
+class ExpressionInspector
+{
+public:
+	ExpressionInspector(Dialect const& _dialect, function<Expression const*(YulString)> const& _ssaValues):
+		m_dialect(_dialect), m_ssaValues(_ssaValues)
+	{}
+
+	Expression const& resolve(Expression const& _expr) const
+	{
+		if (_expr.type() == typeid(Identifier))
+		{
+			if (Expression const* value = m_ssaValues(boost::get<Identifier>(_expr).name))
+				return *value;
+		}
+		return _expr;
+	}
+	bool isConstant(Expression const& _expr) const
+	{
+		return _expr.type() == typeid(Literal) && boost::get<Literal>(_expr).kind == LiteralKind::Number;
+	}
+	u256 value(Expression const& _expr) const
+	{
+		return u256(boost::get<Literal>(_expr).value.str());
+	}
+	bool isOperation(Expression const& _expr, dev::sof::Instruction& _instruction) const
+	{
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expr);
+		if (!instruction)
+			return false;
+		_instruction = instruction->first;
+		return true;
+	}
+	void appendArguments(Expression const& _expr, vector<Expression const*>& _pending) const
+	{
+		auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expr);
+		yulAssert(instruction, "");
+		for (auto argument = instruction->second->rbegin(); argument != instruction->second->rend(); ++argument)
+			_pending.push_back(&*argument);
+	}
+
+private:
+	Dialect const& m_dialect;
+	function<Expression const*(YulString)> const& m_ssaValues;
+};
+
+}
 
 SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, Expression const*> const& _ssaValues
+	function<Expression const*(YulString)> const& _ssaValues
 )
 {
 	auto instruction = instructionAndArguments(_dialect, _expr);
 	if (!instruction)
 		return nullptr;
 
-	static SimplificationRules rules;
+	// The match groups are stored in the rules, so every thread needs its own copy
+	// to be able to apply the optimiser to several functions concurrently.
+	static thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	rules.m_candidates.clear();
+	rules.m_tree.match(_expr, ExpressionInspector(_dialect, _ssaValues), rules.m_candidates);
+	for (size_t index: rules.m_candidates)
 	{
+		auto const& rule = rules.m_rules[index];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -61,7 +117,7 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(dev::sof::Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 boost::optional<std::pair<dev::sof::Instruction, vector<Expression> const*>>
@@ -86,7 +142,12 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	using Symbol = dev::sof::SimplificationRuleTree::Symbol;
+	vector<Symbol> symbols;
+	_rule.pattern.appendSymbols(symbols);
+	assertThrow(symbols.front().kind == Symbol::Kind::Operation, OptimizerException, "Rule does not match an operation.");
+	m_tree.add(symbols);
+	m_rules.push_back(_rule);
 }
 
 SimplificationRules::SimplificationRules()
@@ -125,7 +186,7 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
-	map<YulString, Expression const*> const& _ssaValues
+	function<Expression const*(YulString)> const& _ssaValues
 ) const
 {
 	Expression const* expr = &_expr;
@@ -135,9 +196,8 @@ bool Pattern::matches(
 	if (m_kind != PatternKind::Any && _expr.type() == typeid(Identifier))
 	{
 		YulString varName = boost::get<Identifier>(_expr).name;
-		if (_ssaValues.count(varName))
-			if (Expression const* new_expr = _ssaValues.at(varName))
-				expr = new_expr;
+		if (Expression const* new_expr = _ssaValues(varName))
+			expr = new_expr;
 	}
 	assertThrow(expr, OptimizerException, "");
 
@@ -207,6 +267,30 @@ dev::sof::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
+void Pattern::appendSymbols(vector<dev::sof::SimplificationRuleTree::Symbol>& _symbols) const
+{
+	using Symbol = dev::sof::SimplificationRuleTree::Symbol;
+	switch (m_kind)
+	{
+	case PatternKind::Any:
+		_symbols.push_back(Symbol::any());
+		break;
+	case PatternKind::Constant:
+		_symbols.push_back(m_data ? Symbol::constant(*m_data) : Symbol::constant());
+		break;
+	case PatternKind::Operation:
+		// An operation without arguments in the pattern matches any arguments.
+		_symbols.push_back(
+			m_arguments.empty() && dev::sof::instructionInfo(m_instruction).args > 0 ?
+			Symbol::operationWithAnyArguments(m_instruction) :
+			Symbol::operation(m_instruction)
+		);
+		break;
+	}
+	for (Pattern const& argument: m_arguments)
+		argument.appendSymbols(_symbols);
+}
+
 Expression Pattern::toExpression(SourceLocation const& _location) const
 {
 	if (matchGroup())
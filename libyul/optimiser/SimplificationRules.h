@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libsvmasm/SimplificationRule.h>
+#include <libsvmasm/SimplificationRuleTree.h>
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/AsmData.h>
@@ -46,11 +47,12 @@ public:
 
 	/// @returns a pointer to the first matching pattern and sets the match
 	/// groups accordingly.
-	/// @param _ssaValues values of variables that are assigned exactly once.
+	/// @param _ssaValues returns the value of a variable that is assigned exactly once
+	/// or nullptr if the value is not known.
 	static dev::sof::SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, Expression const*> const& _ssaValues
+		std::function<Expression const*(YulString)> const& _ssaValues
 	);
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
@@ -67,7 +69,11 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::sof::SimplificationRule<Pattern>> m_rules[256];
+	std::vector<dev::sof::SimplificationRule<Pattern>> m_rules;
+	/// Patterns of m_rules, used to find the candidates for a match.
+	dev::sof::SimplificationRuleTree m_tree;
+	/// Buffer for the indices of the candidate rules.
+	std::vector<size_t> m_candidates;
 };
 
 enum class PatternKind
@@ -101,7 +107,7 @@ public:
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
-		std::map<YulString, Expression const*> const& _ssaValues
+		std::function<Expression const*(YulString)> const& _ssaValues
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
@@ -111,6 +117,9 @@ public:
 
 	dev::sof::Instruction instruction() const;
 
+	/// Appends the nodes of this pattern in pre-order to @a _symbols.
+	void appendSymbols(std::vector<dev::sof::SimplificationRuleTree::Symbol>& _symbols) const;
+
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(langutil::SourceLocation const& _location) const;
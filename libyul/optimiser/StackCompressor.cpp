@@ -148,7 +148,7 @@ void eliminateVariables(
 	}
 
 	Rematerialiser::run(_dialect, _node, std::move(varsToEliminate));
-	UnusedPruner::runUntilStabilised(_dialect, _node, _allowMSizeOptimization);
+	UnusedPruner::run(_dialect, _node, _allowMSizeOptimization);
 }
 
 }
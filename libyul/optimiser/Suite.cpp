@@ -23,17 +23,22 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/CodeFingerprint.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
 #include <libyul/optimiser/ConstantOptimiser.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -45,157 +50,320 @@
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserStatistics.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmData.h>
 #include <libyul/AsmPrinter.h>
+#include <libyul/Exceptions.h>
 
 #include <libyul/backends/svm/NoOutputAssembly.h>
 
 #include <libdevcore/CommonData.h>
+#include <libdevcore/Profiler.h>
+#include <libdevcore/ThreadPool.h>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 
 using namespace std;
 using namespace dev;
 using namespace yul;
 
-void OptimiserSuite::run(
-	Dialect const& _dialect,
-	GasMeter const& _meter,
-	Block& _ast,
-	AsmAnalysisInfo const& _analysisInfo,
-	bool _optimizeStackAllocation,
-	set<YulString> const& _externallyUsedIdentifiers
-)
-{
-	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
+char constexpr OptimiserSuite::DefaultSequence[];
+size_t constexpr OptimiserSuite::MaxRounds;
 
-	Block ast = boost::get<Block>(Disambiguator(_dialect, _analysisInfo, reservedIdentifiers)(_ast));
+namespace
+{
 
-	VarDeclInitializer{}(ast);
-	FunctionHoister{}(ast);
-	BlockFlattener{}(ast);
-	ForLoopInitRewriter{}(ast);
-	DeadCodeEliminator{_dialect}(ast);
-	FunctionGrouper{}(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	BlockFlattener{}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	StructuralSimplifier{_dialect}(ast);
-	ControlFlowSimplifier{_dialect}(ast);
-	BlockFlattener{}(ast);
+/// What is known about a unit of code, i.e. about a top-level function or the main code,
+/// see runStep.
+struct UnitState
+{
+	/// Fingerprint of the current code of the unit, if known.
+	boost::optional<CodeFingerprint::Fingerprint> fingerprint;
+	/// Per step, the fingerprint of the code the step was last applied to without changing it.
+	map<char, CodeFingerprint::Fingerprint> unchangedBy;
+};
+
+/// State shared by the steps of a sequence.
+struct StepContext
+{
+	Dialect const& dialect;
+	Block& ast;
+	GasMeter const& meter;
+	set<YulString> const& reservedIdentifiers;
+	/// Created when it is first needed, so that it only knows about the names that are
+	/// still used at that point.
+	unique_ptr<NameDispenser> dispenser;
+	/// State of the units of code by function name, the main code uses the empty name.
+	map<YulString, UnitState> units;
+	/// Pool the functions are optimised on, nullptr if they are optimised sequentially.
+	ThreadPool* threadPool;
+	/// Receives the statistics of the steps if they are recorded, nullptr otherwise.
+	OptimiserStatistics::SuiteRun* statistics;
+	/// Round of the repeated part of the sequence that is currently run, zero outside of it.
+	size_t round;
+
+	NameDispenser& nameDispenser()
+	{
+		if (!dispenser)
+			dispenser = make_unique<NameDispenser>(dialect, ast);
+		return *dispenser;
+	}
+};
 
-	// None of the above can make stack problems worse.
+struct Step
+{
+	char abbreviation;
+	char const* name;
+	/// True if the step handles every function (and the main code) on its own, i.e. the
+	/// result for a function only depends on the function itself. Such steps are applied
+	/// to one function at a time and are not applied again to a function they did not
+	/// change before, see runStep.
+	bool functionLocal;
+	bool usesNameDispenser;
+	/// Applies the step to @a _block, which is the whole code for steps that are not
+	/// function-local.
+	void (*run)(StepContext& _context, Block& _block);
+};
+
+/// Runs the full inliner and records its decisions as remarks if statistics are recorded.
+void runFullInliner(StepContext& _context, Block& _block)
+{
+	vector<string> remarks;
+	FullInliner{_block, _context.nameDispenser(), _context.meter, _context.statistics ? &remarks : nullptr}.run();
+	if (_context.statistics)
+		for (string& remark: remarks)
+			_context.statistics->remarks.push_back({'i', _context.round, std::move(remark)});
+}
 
-	NameDispenser dispenser{_dialect, ast};
+vector<Step> const& allSteps()
+{
+	static vector<Step> const steps{
+		{'f', "BlockFlattener", true, false, [](StepContext&, Block& _b) { BlockFlattener{}(_b); }},
+		{'c', "CommonSubexpressionEliminator", true, false, [](StepContext& _c, Block& _b) { CommonSubexpressionEliminator{_c.dialect}(_b); }},
+		{'n', "ControlFlowSimplifier", true, false, [](StepContext& _c, Block& _b) { ControlFlowSimplifier{_c.dialect}(_b); }},
+		{'D', "DeadCodeEliminator", true, false, [](StepContext& _c, Block& _b) { DeadCodeEliminator{_c.dialect}(_b); }},
+		{'v', "EquivalentFunctionCombiner", false, false, [](StepContext&, Block& _b) { EquivalentFunctionCombiner::run(_b); }},
+		{'e', "ExpressionInliner", false, false, [](StepContext& _c, Block& _b) { ExpressionInliner(_c.dialect, _b).run(); }},
+		{'j', "ExpressionJoiner", true, false, [](StepContext&, Block& _b) { ExpressionJoiner::run(_b); }},
+		{'s', "ExpressionSimplifier", true, false, [](StepContext& _c, Block& _b) { ExpressionSimplifier::run(_c.dialect, _b); }},
+		{'x', "ExpressionSplitter", true, true, [](StepContext& _c, Block& _b) { ExpressionSplitter{_c.dialect, _c.nameDispenser()}(_b); }},
+		{'I', "ForLoopConditionIntoBody", true, false, [](StepContext&, Block& _b) { ForLoopConditionIntoBody{}(_b); }},
+		{'o', "ForLoopInitRewriter", true, false, [](StepContext&, Block& _b) { ForLoopInitRewriter{}(_b); }},
+		{'i', "FullInliner", false, true, runFullInliner},
+		{'g', "FunctionGrouper", false, false, [](StepContext&, Block& _b) { FunctionGrouper{}(_b); }},
+		{'h', "FunctionHoister", false, false, [](StepContext&, Block& _b) { FunctionHoister{}(_b); }},
+		{'F', "FunctionSpecializer", false, true, [](StepContext& _c, Block& _b) { FunctionSpecializer::run(_c.dialect, _c.meter, _b, _c.nameDispenser()); }},
+		{'L', "LoadResolver", true, false, [](StepContext& _c, Block& _b) { LoadResolver::run(_c.dialect, _b); }},
+		{'M', "LoopInvariantCodeMotion", true, false, [](StepContext& _c, Block& _b) { LoopInvariantCodeMotion::run(_c.dialect, _b); }},
+		{'r', "RedundantAssignEliminator", true, false, [](StepContext& _c, Block& _b) { RedundantAssignEliminator::run(_c.dialect, _b); }},
+		{'m', "Rematerialiser", true, false, [](StepContext& _c, Block& _b) { Rematerialiser::run(_c.dialect, _b); }},
+		{'V', "SSAReverser", true, false, [](StepContext&, Block& _b) { SSAReverser::run(_b); }},
+		{'a', "SSATransform", true, true, [](StepContext& _c, Block& _b) { SSATransform::run(_b, _c.nameDispenser()); }},
+		{'t', "StructuralSimplifier", true, false, [](StepContext& _c, Block& _b) { StructuralSimplifier{_c.dialect}(_b); }},
+		{'u', "UnusedPruner", false, false, [](StepContext& _c, Block& _b) { UnusedPruner::run(_c.dialect, _b, _c.reservedIdentifiers); }},
+		{'d', "VarDeclInitializer", true, false, [](StepContext&, Block& _b) { VarDeclInitializer{}(_b); }}
+	};
+	return steps;
+}
 
-	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < 12; ++rounds)
-	{
-		{
-			size_t newSize = CodeSize::codeSizeIncludingFunctions(ast);
-			if (newSize == codeSize)
-				break;
-			codeSize = newSize;
-		}
+Step const* findStep(char _abbreviation)
+{
+	for (Step const& step: allSteps())
+		if (step.abbreviation == _abbreviation)
+			return &step;
+	return nullptr;
+}
 
-		{
-			// Turn into SSA and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-
-			ExpressionSimplifier::run(_dialect, ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-		}
+bool isWhitespace(char _c)
+{
+	return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r';
+}
 
-		{
-			// still in SSA, perform structural simplification
-			ControlFlowSimplifier{_dialect}(ast);
-			StructuralSimplifier{_dialect}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		}
-		{
-			// simplify again
-			CommonSubexpressionEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		}
+/// @returns true if no top-level statement apart from function definitions follows
+/// the first top-level function definition, which is the case after the FunctionHoister.
+bool isHoisted(Block const& _ast)
+{
+	bool seenFunction = false;
+	for (auto const& statement: _ast.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+			seenFunction = true;
+		else if (seenFunction)
+			return false;
+	return true;
+}
 
-		{
-			// reverse SSA
-			SSAReverser::run(ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+/// Applies a function-local step to a single unit of code, unless the step did not change
+/// the very same code the last time it was applied to it.
+void runOnUnit(Step const& _step, StepContext& _context, UnitState& _state, Block& _unit)
+{
+	if (!_state.fingerprint)
+		_state.fingerprint = CodeFingerprint::run(_unit);
+	auto unchanged = _state.unchangedBy.find(_step.abbreviation);
+	if (unchanged != _state.unchangedBy.end() && unchanged->second == *_state.fingerprint)
+		return;
+
+	_step.run(_context, _unit);
+
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(_unit);
+	if (fingerprint == *_state.fingerprint)
+		_state.unchangedBy[_step.abbreviation] = fingerprint;
+	else
+		_state.fingerprint = fingerprint;
+}
 
-			ExpressionJoiner::run(ast);
-			ExpressionJoiner::run(ast);
-		}
+/// Applies a step to the code.
+/// If the code is hoisted, function-local steps are applied to the main code and to each
+/// top-level function separately, which is equivalent to applying them to the whole code.
+/// This way, a step can be skipped for all the functions it already failed to change
+/// before, which is the common case in the later rounds of the optimiser. Applying the
+/// step again would not change them either, because its result does not depend on
+/// anything outside of the function and it does not request new names unless it changes
+/// the code.
+/// The functions are processed concurrently, except by steps that request new names:
+/// Those are applied to the functions in the order they appear in, so that the names do
+/// not depend on the number of threads.
+void runStep(Step const& _step, StepContext& _context)
+{
+	if (!_step.functionLocal || !isHoisted(_context.ast))
+	{
+		_step.run(_context, _context.ast);
+		for (auto& unit: _context.units)
+			unit.second.fingerprint.reset();
+		return;
+	}
 
-		// should have good "compilability" property here.
+	// The name dispenser has to see the whole code when it is created.
+	if (_step.usesNameDispenser)
+		_context.nameDispenser();
+
+	vector<Statement>& statements = _context.ast.statements;
+	auto firstFunction = find_if(statements.begin(), statements.end(), [](Statement const& _statement) {
+		return _statement.type() == typeid(FunctionDefinition);
+	});
+
+	// The first unit is the main code, which is stored under the empty name.
+	vector<Block> units;
+	vector<UnitState*> states;
+	units.emplace_back(Block{
+		_context.ast.location,
+		vector<Statement>(make_move_iterator(statements.begin()), make_move_iterator(firstFunction))
+	});
+	states.emplace_back(&_context.units[YulString{}]);
+	for (auto it = firstFunction; it != statements.end(); ++it)
+	{
+		states.emplace_back(&_context.units[boost::get<FunctionDefinition>(*it).name]);
+		units.emplace_back(Block{_context.ast.location, {}});
+		units.back().statements.emplace_back(std::move(*it));
+	}
 
-		{
-			// run functional expression inliner
-			ExpressionInliner(_dialect, ast).run();
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		}
+	auto runOnUnitAt = [&](size_t _index) { runOnUnit(_step, _context, *states[_index], units[_index]); };
+	if (_step.usesNameDispenser || !_context.threadPool)
+		for (size_t i = 0; i < units.size(); ++i)
+			runOnUnitAt(i);
+	else
+		_context.threadPool->run(units.size(), runOnUnitAt);
 
-		{
-			// Turn into SSA again and simplify
-			ExpressionSplitter{_dialect, dispenser}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-		}
+	vector<Statement> result = std::move(units.front().statements);
+	for (size_t i = 1; i < units.size(); ++i)
+	{
+		assertThrow(
+			units[i].statements.size() == 1 && units[i].statements.front().type() == typeid(FunctionDefinition),
+			OptimizerException,
+			string(_step.name) + " changed the structure of the top-level code."
+		);
+		result.emplace_back(std::move(units[i].statements.front()));
+	}
+	statements = std::move(result);
+}
 
+void runSequence(string const& _sequence, StepContext& _context)
+{
+	for (size_t i = 0; i < _sequence.size(); ++i)
+	{
+		char const c = _sequence[i];
+		if (isWhitespace(c))
+			continue;
+		if (c == '[')
 		{
-			// run full inliner
-			FunctionGrouper{}(ast);
-			EquivalentFunctionCombiner::run(ast);
-			FullInliner{ast, dispenser}.run();
-			BlockFlattener{}(ast);
+			size_t const end = _sequence.find(']', i);
+			string const body = _sequence.substr(i + 1, end - i - 1);
+			size_t codeSize = 0;
+			size_t rounds = 0;
+			for (; rounds < OptimiserSuite::MaxRounds; ++rounds)
+			{
+				size_t newSize = CodeSize::codeSizeIncludingFunctions(_context.ast);
+				if (newSize == codeSize)
+					break;
+				codeSize = newSize;
+				_context.round = rounds + 1;
+				runSequence(body, _context);
+			}
+			_context.round = 0;
+			if (_context.statistics)
+				_context.statistics->rounds.push_back(rounds);
+			i = end;
 		}
-
+		else if (_context.statistics)
 		{
-			// SSA plus simplify
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			ExpressionSimplifier::run(_dialect, ast);
-			StructuralSimplifier{_dialect}(ast);
-			BlockFlattener{}(ast);
-			DeadCodeEliminator{_dialect}(ast);
-			ControlFlowSimplifier{_dialect}(ast);
-			CommonSubexpressionEliminator{_dialect}(ast);
-			SSATransform::run(ast, dispenser);
-			RedundantAssignEliminator::run(_dialect, ast);
-			RedundantAssignEliminator::run(_dialect, ast);
-			UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-			CommonSubexpressionEliminator{_dialect}(ast);
+			OptimiserStatistics::StepRun stepRun;
+			stepRun.step = c;
+			stepRun.round = _context.round;
+			stepRun.nodesBefore = NodeCount::nodeCount(_context.ast);
+			stepRun.codeSizeBefore = CodeSize::codeSizeIncludingFunctions(_context.ast);
+			auto const start = chrono::steady_clock::now();
+			runStep(*findStep(c), _context);
+			stepRun.time = chrono::steady_clock::now() - start;
+			stepRun.nodesAfter = NodeCount::nodeCount(_context.ast);
+			stepRun.codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_context.ast);
+			_context.statistics->steps.push_back(stepRun);
 		}
+		else
+			runStep(*findStep(c), _context);
 	}
+}
 
-	// Make source short and pretty.
+}
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+void OptimiserSuite::run(
+	Dialect const& _dialect,
+	GasMeter const& _meter,
+	Block& _ast,
+	AsmAnalysisInfo const& _analysisInfo,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _externallyUsedIdentifiers,
+	string const& _sequence,
+	ThreadPool* _threadPool,
+	OptimiserStatistics* _statistics
+)
+{
+	validateSequence(_sequence);
 
-	SSAReverser::run(ast);
-	CommonSubexpressionEliminator{_dialect}(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+	ScopedPhase phase("yulOptimiser");
+	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
+
+	Block ast = boost::get<Block>(Disambiguator(_dialect, _analysisInfo, reservedIdentifiers)(_ast));
 
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
+	OptimiserStatistics::SuiteRun statistics;
+	StepContext context{
+		_dialect,
+		ast,
+		_meter,
+		reservedIdentifiers,
+		nullptr,
+		{},
+		_threadPool,
+		_statistics ? &statistics : nullptr,
+		0
+	};
+	runSequence(_sequence, context);
+	if (_statistics)
+		_statistics->add(std::move(statistics));
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -215,3 +383,34 @@ void OptimiserSuite::run(
 
 	_ast = std::move(ast);
 }
+
+map<char, string> OptimiserSuite::stepAbbreviationToNameMap()
+{
+	map<char, string> result;
+	for (Step const& step: allSteps())
+		result[step.abbreviation] = step.name;
+	return result;
+}
+
+void OptimiserSuite::validateSequence(string const& _sequence)
+{
+	bool insideBrackets = false;
+	for (char c: _sequence)
+		if (c == '[')
+		{
+			assertThrow(!insideBrackets, OptimizerException, "Nested brackets are not allowed in the optimizer step sequence.");
+			insideBrackets = true;
+		}
+		else if (c == ']')
+		{
+			assertThrow(insideBrackets, OptimizerException, "Unbalanced brackets in the optimizer step sequence.");
+			insideBrackets = false;
+		}
+		else if (!isWhitespace(c))
+			assertThrow(
+				findStep(c),
+				OptimizerException,
+				"'" + string(1, c) + "' is not a valid optimizer step abbreviation."
+			);
+	assertThrow(!insideBrackets, OptimizerException, "Unbalanced brackets in the optimizer step sequence.");
+}
@@ -24,7 +24,14 @@
 #include <libyul/YulString.h>
 #include <liblangutil/SVMVersion.h>
 
+#include <map>
 #include <set>
+#include <string>
+
+namespace dev
+{
+class ThreadPool;
+}
 
 namespace yul
 {
@@ -32,21 +39,65 @@ namespace yul
 struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
+class OptimiserStatistics;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics
+ *
+ * The steps that are run are given by a sequence of step abbreviations (see
+ * stepAbbreviationToNameMap). A part of the sequence enclosed in brackets is repeated until
+ * the code size does not change anymore, but at most MaxRounds times. Whitespace is ignored.
+ * The sequence is run after the Disambiguator and followed by the steps that prepare the
+ * code for code generation (StackCompressor, ConstantOptimiser, VarNameCleaner, ...).
+ *
+ * Steps that only work inside functions are applied to the functions concurrently on the
+ * threads of the given pool. The pool is owned by the caller, so that its threads are reused
+ * for every run. The result does not depend on the number of threads.
+ *
+ * If statistics are passed, the time and the effect of every step of the sequence are
+ * recorded in them.
  */
 class OptimiserSuite
 {
 public:
+	/// The sequence of steps that is run by default.
+	static char constexpr DefaultSequence[] =
+		"dhfoDgvufntnf"
+		"["
+			"xarrscLM"  // Turn into SSA and simplify
+			"ntnfDu"    // Still in SSA, perform structural simplification
+			"cu"        // Simplify again
+			"Vcujj"     // Reverse SSA
+			"eu"        // Run functional expression inliner
+			"xarrc"     // Turn into SSA again and simplify
+			"gvifF"     // Run full inliner and specialise functions
+			"arrstfDncarrLuc" // SSA plus simplify
+		"]"
+		"jmujuju"   // Make source short and pretty
+		"Vcujmu";
+	/// Maximum number of repetitions of a part of the sequence in brackets.
+	static size_t constexpr MaxRounds = 12;
+
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const& _meter,
 		Block& _ast,
 		AsmAnalysisInfo const& _analysisInfo,
 		bool _optimizeStackAllocation,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		std::string const& _sequence = DefaultSequence,
+		dev::ThreadPool* _threadPool = nullptr,
+		OptimiserStatistics* _statistics = nullptr
 	);
+
+	/// @returns a map from the abbreviation of every step that can be used in a sequence
+	/// to the name of the step.
+	static std::map<char, std::string> stepAbbreviationToNameMap();
+
+	/// Checks that @a _sequence only consists of step abbreviations, whitespace and
+	/// properly closed brackets, which must not be nested.
+	/// Throws an OptimizerException describing the problem otherwise.
+	static void validateSequence(std::string const& _sequence);
 };
 
 }
@@ -22,7 +22,6 @@
 
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
 
@@ -32,92 +31,58 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
-UnusedPruner::UnusedPruner(
-	Dialect const& _dialect,
-	Block& _ast,
-	bool _allowMSizeOptimization,
-	set<YulString> const& _externallyUsedFunctions
-):
-	m_dialect(_dialect),
-	m_allowMSizeOptimization(_allowMSizeOptimization)
-{
-	m_references = ReferencesCounter::countReferences(_ast);
-	for (auto const& f: _externallyUsedFunctions)
-		++m_references[f];
-}
+size_t constexpr UnusedPruner::npos;
 
 UnusedPruner::UnusedPruner(
 	Dialect const& _dialect,
-	FunctionDefinition& _function,
 	bool _allowMSizeOptimization,
+	map<YulString, size_t> _references,
 	set<YulString> const& _externallyUsedFunctions
 ):
 	m_dialect(_dialect),
-	m_allowMSizeOptimization(_allowMSizeOptimization)
+	m_allowMSizeOptimization(_allowMSizeOptimization),
+	m_references(std::move(_references))
 {
-	m_references = ReferencesCounter::countReferences(_function);
 	for (auto const& f: _externallyUsedFunctions)
 		++m_references[f];
 }
 
 void UnusedPruner::operator()(Block& _block)
 {
-	for (auto&& statement: _block.statements)
+	size_t const first = m_statements.size();
+	m_blockStarts[&_block] = first;
+	for (auto& statement: _block.statements)
+	{
+		size_t const index = m_statements.size();
+		m_statements.push_back({&statement, m_currentFunction, 0});
 		if (statement.type() == typeid(FunctionDefinition))
-		{
-			FunctionDefinition& funDef = boost::get<FunctionDefinition>(statement);
-			if (!used(funDef.name))
-			{
-				subtractReferences(ReferencesCounter::countReferences(funDef.body));
-				statement = Block{std::move(funDef.location), {}};
-			}
-		}
+			m_declarations[boost::get<FunctionDefinition>(statement).name].push_back(index);
 		else if (statement.type() == typeid(VariableDeclaration))
-		{
-			VariableDeclaration& varDecl = boost::get<VariableDeclaration>(statement);
-			// Multi-variable declarations are special. We can only remove it
-			// if all variables are unused and the right-hand-side is either
-			// movable or it returns a single value. In the latter case, we
-			// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
-			// `drop(f())`).
-			if (boost::algorithm::none_of(
-				varDecl.variables,
-				[=](TypedName const& _typedName) { return used(_typedName.name); }
-			))
-			{
-				if (!varDecl.value)
-					statement = Block{std::move(varDecl.location), {}};
-				else if (SideEffectsCollector(m_dialect, *varDecl.value).sideEffectFree(m_allowMSizeOptimization))
-				{
-					subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
-					statement = Block{std::move(varDecl.location), {}};
-				}
-				else if (varDecl.variables.size() == 1)
-					// In pure Yul, this should be replaced by a function call to `drop`
-					// instead of `pop`.
-					statement = ExpressionStatement{varDecl.location, FunctionalInstruction{
-						varDecl.location,
-						dev::sof::Instruction::POP,
-						{*std::move(varDecl.value)}
-					}};
-			}
-		}
-		else if (statement.type() == typeid(ExpressionStatement))
-		{
-			ExpressionStatement& exprStmt = boost::get<ExpressionStatement>(statement);
-			if (SideEffectsCollector(m_dialect, exprStmt.expression).sideEffectFree(m_allowMSizeOptimization))
-			{
-				subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
-				statement = Block{std::move(exprStmt.location), {}};
-			}
-		}
+			for (auto const& var: boost::get<VariableDeclaration>(statement).variables)
+				m_declarations[var.name].push_back(index);
+	}
 
-	removeEmptyBlocks(_block);
+	// The walk visits the statements in the order of their indices, so the
+	// first round can examine them right away and skip the bodies of the
+	// functions it removes.
+	for (m_position = first; m_position < m_statements.size(); ++m_position)
+		examine(m_position);
 
-	ASTModifier::operator()(_block);
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+		if (m_statements[first + i].removedInRound)
+			continue;
+		else if (_block.statements[i].type() == typeid(FunctionDefinition))
+		{
+			size_t const outerFunction = m_currentFunction;
+			m_currentFunction = first + i;
+			visit(_block.statements[i]);
+			m_currentFunction = outerFunction;
+		}
+		else
+			visit(_block.statements[i]);
 }
 
-void UnusedPruner::runUntilStabilised(
+void UnusedPruner::run(
 	Dialect const& _dialect,
 	Block& _ast,
 	bool _allowMSizeOptization,
@@ -126,38 +91,179 @@ void UnusedPruner::runUntilStabilised(
 {
 	_allowMSizeOptization = !SideEffectsCollector(_dialect, _ast).containsMSize();
 
-	while (true)
-	{
-		UnusedPruner pruner(_dialect, _ast, _allowMSizeOptization, _externallyUsedFunctions);
-		pruner(_ast);
-		if (!pruner.shouldRunAgain())
-			return;
-	}
+	UnusedPruner pruner(
+		_dialect,
+		_allowMSizeOptization,
+		ReferencesCounter::countReferences(_ast),
+		_externallyUsedFunctions
+	);
+	pruner(_ast);
+	pruner.prune();
+	pruner.removeEmptyBlocks(_ast);
 }
 
-void UnusedPruner::runUntilStabilised(
+void UnusedPruner::run(
 	Dialect const& _dialect,
 	Block& _ast,
 	set<YulString> const& _externallyUsedFunctions
 )
 {
 	bool allowMSizeOptimization = !SideEffectsCollector(_dialect, _ast).containsMSize();
-	runUntilStabilised(_dialect, _ast, allowMSizeOptimization, _externallyUsedFunctions);
+	run(_dialect, _ast, allowMSizeOptimization, _externallyUsedFunctions);
 }
 
-void UnusedPruner::runUntilStabilised(
+void UnusedPruner::run(
 	Dialect const& _dialect,
 	FunctionDefinition& _function,
 	bool _allowMSizeOptimization,
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
+	UnusedPruner pruner(
+		_dialect,
+		_allowMSizeOptimization,
+		ReferencesCounter::countReferences(_function),
+		_externallyUsedFunctions
+	);
+	pruner(_function);
+	pruner.prune();
+	pruner.removeEmptyBlocks(_function.body);
+}
+
+void UnusedPruner::prune()
+{
+	while (!m_worklist.empty())
+	{
+		tie(m_round, m_position) = *m_worklist.begin();
+		m_worklist.erase(m_worklist.begin());
+		if (!m_statements[m_position].removedInRound && !removedWithFunction(m_position))
+			examine(m_position);
+	}
+}
+
+void UnusedPruner::examine(size_t _index)
+{
+	Statement& statement = *m_statements[_index].statement;
+	if (statement.type() == typeid(FunctionDefinition))
+	{
+		FunctionDefinition& funDef = boost::get<FunctionDefinition>(statement);
+		if (!used(funDef.name))
+		{
+			subtractReferences(ReferencesCounter::countReferences(funDef.body));
+			m_statements[_index].removedInRound = m_round;
+			statement = Block{std::move(funDef.location), {}};
+		}
+	}
+	else if (statement.type() == typeid(VariableDeclaration))
+	{
+		VariableDeclaration& varDecl = boost::get<VariableDeclaration>(statement);
+		// Multi-variable declarations are special. We can only remove it
+		// if all variables are unused and the right-hand-side is either
+		// movable or it returns a single value. In the latter case, we
+		// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
+		// `drop(f())`).
+		if (boost::algorithm::none_of(
+			varDecl.variables,
+			[=](TypedName const& _typedName) { return used(_typedName.name); }
+		))
+		{
+			if (!varDecl.value)
+			{
+				m_statements[_index].removedInRound = m_round;
+				statement = Block{std::move(varDecl.location), {}};
+			}
+			else if (SideEffectsCollector(m_dialect, *varDecl.value).sideEffectFree(m_allowMSizeOptimization))
+			{
+				subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
+				m_statements[_index].removedInRound = m_round;
+				statement = Block{std::move(varDecl.location), {}};
+			}
+			else if (varDecl.variables.size() == 1)
+				// In pure Yul, this should be replaced by a function call to `drop`
+				// instead of `pop`.
+				statement = ExpressionStatement{varDecl.location, FunctionalInstruction{
+					varDecl.location,
+					dev::sof::Instruction::POP,
+					{*std::move(varDecl.value)}
+				}};
+		}
+	}
+	else if (statement.type() == typeid(ExpressionStatement))
+	{
+		ExpressionStatement& exprStmt = boost::get<ExpressionStatement>(statement);
+		if (SideEffectsCollector(m_dialect, exprStmt.expression).sideEffectFree(m_allowMSizeOptimization))
+		{
+			subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
+			m_statements[_index].removedInRound = m_round;
+			statement = Block{std::move(exprStmt.location), {}};
+		}
+	}
+}
+
+bool UnusedPruner::removedWithFunction(size_t _index) const
+{
+	for (size_t function = m_statements[_index].function; function != npos; function = m_statements[function].function)
+		if (m_statements[function].removedInRound)
+			return true;
+	return false;
+}
+
+size_t UnusedPruner::removeEmptyBlocks(Block& _block)
+{
+	// A statement that is removed becomes an empty block, which is removed from
+	// the surrounding block in the same round. A block that became empty is only
+	// removed from the surrounding block in the next round, if there is one.
+	size_t emptiedInRound = 0;
+	vector<size_t> removedInRound;
+	size_t index = m_blockStarts.at(&_block);
+	for (auto& statement: _block.statements)
+	{
+		size_t round = npos;
+		if (m_statements[index].removedInRound)
+			round = m_statements[index].removedInRound;
+		else if (statement.type() == typeid(Block))
+		{
+			size_t const emptied = removeEmptyBlocks(boost::get<Block>(statement));
+			if (emptied != npos && emptied + 1 <= m_finalRound)
+				round = emptied + 1;
+		}
+		else
+			removeNestedEmptyBlocks(statement);
+		removedInRound.push_back(round);
+		if (round == npos)
+			emptiedInRound = npos;
+		else if (emptiedInRound != npos)
+			emptiedInRound = max(emptiedInRound, round);
+		++index;
+	}
+
+	size_t kept = 0;
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+		if (removedInRound[i] == npos)
+		{
+			if (kept != i)
+				_block.statements[kept] = std::move(_block.statements[i]);
+			++kept;
+		}
+	_block.statements.erase(_block.statements.begin() + kept, _block.statements.end());
+	return emptiedInRound;
+}
+
+void UnusedPruner::removeNestedEmptyBlocks(Statement& _statement)
+{
+	if (_statement.type() == typeid(FunctionDefinition))
+		removeEmptyBlocks(boost::get<FunctionDefinition>(_statement).body);
+	else if (_statement.type() == typeid(If))
+		removeEmptyBlocks(boost::get<If>(_statement).body);
+	else if (_statement.type() == typeid(Switch))
+		for (auto& switchCase: boost::get<Switch>(_statement).cases)
+			removeEmptyBlocks(switchCase.body);
+	else if (_statement.type() == typeid(ForLoop))
 	{
-		UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
-		pruner(_function);
-		if (!pruner.shouldRunAgain())
-			return;
+		ForLoop& forLoop = boost::get<ForLoop>(_statement);
+		removeEmptyBlocks(forLoop.pre);
+		removeEmptyBlocks(forLoop.post);
+		removeEmptyBlocks(forLoop.body);
 	}
 }
 
@@ -170,9 +276,24 @@ void UnusedPruner::subtractReferences(map<YulString, size_t> const& _subtrahend)
 {
 	for (auto const& ref: _subtrahend)
 	{
-		assertThrow(m_references.count(ref.first), OptimizerException, "");
-		assertThrow(m_references.at(ref.first) >= ref.second, OptimizerException, "");
-		m_references[ref.first] -= ref.second;
-		m_shouldRunAgain = true;
+		auto it = m_references.find(ref.first);
+		assertThrow(it != m_references.end(), OptimizerException, "");
+		assertThrow(it->second >= ref.second, OptimizerException, "");
+		it->second -= ref.second;
+		// Removing references makes another round necessary.
+		m_finalRound = max(m_finalRound, m_round + 1);
+		if (it->second > 0)
+			continue;
+		auto declarations = m_declarations.find(ref.first);
+		if (declarations == m_declarations.end())
+			continue;
+		// The declarations are examined again in this round if they
+		// have not been visited yet, otherwise in the next round.
+		// The first round visits all statements anyway.
+		for (size_t declaration: declarations->second)
+			if (declaration <= m_position)
+				m_worklist.emplace(m_round + 1, declaration);
+			else if (m_round > 1)
+				m_worklist.emplace(m_round, declaration);
 	}
 }
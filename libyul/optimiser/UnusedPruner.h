@@ -25,6 +25,8 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace yul
 {
@@ -34,6 +36,13 @@ struct Dialect;
  * Optimisation stage that removes unused variables and functions and also
  * removes side-effect-free expression statements.
  *
+ * The reference counts are maintained while statements are removed. If the
+ * last reference to a variable or function is removed, its declaration is put
+ * on a worklist and examined again, so that the removals cascade in a single
+ * run. The statements are examined in rounds that each follow the order of a
+ * walk over the AST, which also determines the blocks that become empty and
+ * are removed.
+ *
  * Note that this does not remove circular references.
  *
  * Prerequisite: Disambiguator
@@ -41,45 +50,31 @@ struct Dialect;
 class UnusedPruner: public ASTModifier
 {
 public:
-	UnusedPruner(
-		Dialect const& _dialect,
-		Block& _ast,
-		bool _allowMSizeOptimization,
-		std::set<YulString> const& _externallyUsedFunctions = {}
-	);
-	UnusedPruner(
-		Dialect const& _dialect,
-		FunctionDefinition& _function,
-		bool _allowMSizeOptimization,
-		std::set<YulString> const& _externallyUsedFunctions = {}
-	);
-
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
 
-	// @returns true iff the code changed in the previous run.
-	bool shouldRunAgain() const { return m_shouldRunAgain; }
-
-	// Run the pruner until the code does not change anymore.
-	static void runUntilStabilised(
+	// Remove all unused variables and functions, including the ones
+	// that only become unused through the removals.
+	static void run(
 		Dialect const& _dialect,
 		Block& _ast,
 		bool _allowMSizeOptization,
 		std::set<YulString> const& _externallyUsedFunctions = {}
 	);
 
-	static void runUntilStabilised(
+	static void run(
 		Dialect const& _dialect,
 		Block& _ast,
 		std::set<YulString> const& _externallyUsedFunctions = {}
 	);
 
-	// Run the pruner until the code does not change anymore.
+	// Remove all unused variables and functions, including the ones
+	// that only become unused through the removals.
 	// Only run on the given function.
 	// @param _allowMSizeOptimization if true, allows to remove instructions
 	//        whose only side-effect is a potential change of the return value of
 	//        the msize instruction.
-	static void runUntilStabilised(
+	static void run(
 		Dialect const& _dialect,
 		FunctionDefinition& _functionDefinition,
 		bool _allowMSizeOptimization,
@@ -87,13 +82,57 @@ public:
 	);
 
 private:
+	static size_t constexpr npos = size_t(-1);
+
+	struct StatementInfo
+	{
+		Statement* statement = nullptr;
+		/// Index of the innermost function definition containing the statement or npos.
+		size_t function = npos;
+		/// Round in which the statement was removed or zero.
+		size_t removedInRound = 0;
+	};
+
+	UnusedPruner(
+		Dialect const& _dialect,
+		bool _allowMSizeOptimization,
+		std::map<YulString, size_t> _references,
+		std::set<YulString> const& _externallyUsedFunctions
+	);
+
+	/// Runs the rounds after the first one, which is done by the walk,
+	/// until the worklist is empty.
+	void prune();
+	/// Removes the statement with the given index if it is unused or side-effect-free.
+	void examine(size_t _index);
+	/// @returns true if the statement is part of a function that was removed.
+	bool removedWithFunction(size_t _index) const;
+	/// Removes the empty blocks from @a _block and the blocks nested in it.
+	/// @returns the round in which @a _block became empty or npos if it did not.
+	size_t removeEmptyBlocks(Block& _block);
+	void removeNestedEmptyBlocks(Statement& _statement);
+
 	bool used(YulString _name) const;
 	void subtractReferences(std::map<YulString, size_t> const& _subtrahend);
 
 	Dialect const& m_dialect;
 	bool m_allowMSizeOptimization = false;
-	bool m_shouldRunAgain = false;
 	std::map<YulString, size_t> m_references;
+
+	/// Statements in the order in which they are examined in each round.
+	std::vector<StatementInfo> m_statements;
+	/// Index of the first statement of each block.
+	std::unordered_map<Block const*, size_t> m_blockStarts;
+	/// Indices of the statements declaring a variable or function.
+	std::map<YulString, std::vector<size_t>> m_declarations;
+	size_t m_currentFunction = npos;
+
+	/// Pending examinations as pairs of round and statement index.
+	std::set<std::pair<size_t, size_t>> m_worklist;
+	size_t m_round = 1;
+	size_t m_position = 0;
+	/// Last round, i.e. the first round in which no references were removed.
+	size_t m_finalRound = 1;
 };
 
 }
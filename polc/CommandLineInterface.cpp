@@ -30,11 +30,16 @@
 #include <libpolynomial/ast/ASTPrinter.h>
 #include <libpolynomial/ast/ASTJsonConverter.h>
 #include <libpolynomial/analysis/NameAndTypeResolver.h>
+#include <libpolynomial/codegen/InlineAssemblyCache.h>
+#include <libpolynomial/codegen/YulFunctionRepository.h>
 #include <libpolynomial/interface/CompilerStack.h>
 #include <libpolynomial/interface/StandardCompiler.h>
 #include <libpolynomial/interface/GasEstimator.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Exceptions.h>
+#include <libyul/optimiser/OptimiserStatistics.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libsvmasm/Instruction.h>
 #include <libsvmasm/GasMeter.h>
@@ -48,6 +53,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <memory>
 
@@ -63,9 +69,12 @@
 	#include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <numeric>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -107,6 +116,7 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -120,7 +130,10 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
+static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerStats = "yul-optimizer-stats";
 static string const g_strIR = "ir";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
@@ -136,6 +149,7 @@ static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -143,6 +157,7 @@ static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
+static string const g_strTimePasses = "time-passes";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
@@ -161,12 +176,16 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
+static string const g_argYulOptimizations = g_strYulOptimizations;
+static string const g_argYulOptimizerStats = g_strYulOptimizerStats;
 static string const g_argIR = g_strIR;
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
@@ -180,8 +199,10 @@ static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argServer = g_strServer;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTimePasses = g_strTimePasses;
 static string const g_argVersion = g_strVersion;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
@@ -633,6 +654,35 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Polynomial, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_argYulOptimizations.c_str(),
+			po::value<string>()->value_name("steps"),
+			"Sequence of steps run by the Yul optimizer, given by their abbreviations. "
+			"Steps in brackets are repeated until the code size does not change anymore. "
+			"Requires the Yul optimizer to be enabled."
+		)
+		(
+			(g_argJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to parse sources, to optimize and assemble independent contracts and to "
+			"apply the Yul optimizer to independent functions concurrently."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the compilation results of every contract in the given directory and re-use them "
+			"when a contract is compiled again with the same sources and settings."
+		)
+		(
+			g_argTimePasses.c_str(),
+			"Print the time, number of invocations and peak memory usage of every compilation phase "
+			"to standard error at the end of the run."
+		)
+		(
+			g_argYulOptimizerStats.c_str(),
+			"Print the number of applications, the time and the effect on the code of every step of the "
+			"Yul optimizer and the number of rounds until the optimizer converged to standard error."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -658,6 +708,12 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options. "
+			"Every line read from standard input is compiled as a separate Standard JSON input "
+			"and its result is written to the standard output as a single line."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and --optimize and assumes input is assembly."
@@ -838,6 +894,21 @@ bool CommandLineInterface::processInput()
 		return true;
 	}
 
+	if (m_args.count(g_argServer))
+	{
+		StandardCompiler compiler(fileReader);
+		string request;
+		while (getline(std::cin, request))
+		{
+			if (boost::algorithm::trim_copy(request).empty())
+				continue;
+			// Every request is compiled in isolation, files read by a previous one are not re-used.
+			m_sourceCodes.clear();
+			sout() << compiler.compile(request) << endl;
+		}
+		return true;
+	}
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
@@ -858,6 +929,28 @@ bool CommandLineInterface::processInput()
 		m_svmVersion = *versionOption;
 	}
 
+	if (m_args[g_argJobs].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_argJobs << ": must be at least 1." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argYulOptimizations))
+	{
+		try
+		{
+			yul::OptimiserSuite::validateSequence(m_args[g_argYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() <<
+				"Invalid option for --" << g_argYulOptimizations << ": " <<
+				*boost::get_error_info<errinfo_comment>(_exception) <<
+				endl;
+			return false;
+		}
+	}
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		// switch to assembly mode
@@ -893,6 +986,11 @@ bool CommandLineInterface::processInput()
 				endl;
 			return false;
 		}
+		if (m_args.count(g_argYulOptimizations) && !optimize)
+		{
+			serr() << "--" << g_argYulOptimizations << " requires the optimizer to be enabled." << endl;
+			return false;
+		}
 		serr() <<
 			"Warning: Yul and its optimizer are still experimental. Please use the output with care." <<
 			endl;
@@ -932,9 +1030,32 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (m_args.count(g_argYulOptimizations))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_argYulOptimizations << " requires the Yul optimizer to be enabled (--" << g_strOptimizeYul << ")." << endl;
+				return false;
+			}
+			settings.yulOptimiserSteps = m_args[g_argYulOptimizations].as<string>();
+		}
 		m_compiler->setOptimiserSettings(settings);
 
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+		if (m_args.count(g_argCacheDir))
+			m_compiler->setCacheDirectory(m_args[g_argCacheDir].as<string>());
+		m_compiler->enableProfiling(m_args.count(g_argTimePasses));
+		m_compiler->enableYulOptimiserStatistics(m_args.count(g_argYulOptimizerStats));
+
 		bool successful = m_compiler->compile();
+		if (successful && m_args.count(g_argCacheDir))
+			serr(false) <<
+				"Compilation cache: " <<
+				m_compiler->cacheHits() <<
+				" hit(s), " <<
+				m_compiler->cacheMisses() <<
+				" miss(es)." <<
+				endl;
 
 		for (auto const& error: m_compiler->errors())
 		{
@@ -943,7 +1064,11 @@ bool CommandLineInterface::processInput()
 		}
 
 		if (!successful)
+		{
+			handleTimePasses();
+			handleYulOptimizerStatistics(m_compiler->yulOptimiserStatistics().get());
 			return false;
+		}
 	}
 	catch (CompilerError const& _exception)
 	{
@@ -1149,7 +1274,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1255,13 +1380,18 @@ bool CommandLineInterface::assemble(
 {
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
+	shared_ptr<yul::OptimiserStatistics> optimiserStatistics;
+	if (m_args.count(g_argYulOptimizerStats))
+		optimiserStatistics = make_shared<yul::OptimiserStatistics>();
+	auto threadPool = make_shared<ThreadPool>(m_args[g_argJobs].as<unsigned>());
 	for (auto const& src: m_sourceCodes)
 	{
-		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(
-			m_svmVersion,
-			_language,
-			_optimize ? OptimiserSettings::full() : OptimiserSettings::minimal()
-		);
+		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
+		if (m_args.count(g_argYulOptimizations))
+			settings.yulOptimiserSteps = m_args[g_argYulOptimizations].as<string>();
+		settings.yulOptimiserThreadPool = threadPool;
+		settings.yulOptimiserStatistics = optimiserStatistics;
+		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_svmVersion, _language, settings);
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -1298,6 +1428,7 @@ bool CommandLineInterface::assemble(
 		if (!Error::containsOnlyWarnings(stack.errors()))
 			successful = false;
 	}
+	handleYulOptimizerStatistics(optimiserStatistics.get());
 
 	if (!successful)
 		return false;
@@ -1346,6 +1477,125 @@ bool CommandLineInterface::assemble(
 	return true;
 }
 
+void CommandLineInterface::handleTimePasses()
+{
+	if (!m_args.count(g_argTimePasses))
+		return;
+
+	ostringstream out;
+	out << fixed;
+	auto const printRow = [&](string const& _name, Profiler::Statistics const& _statistics)
+	{
+		out <<
+			setw(40) << left << _name << right <<
+			setw(12) << setprecision(3) << double(_statistics.time.count()) / 1e6 <<
+			setw(8) << _statistics.calls <<
+			setw(12) << setprecision(1) << double(_statistics.peakRSS) / (1024 * 1024) <<
+			endl;
+	};
+
+	out << endl << "======= Compilation phases =======" << endl;
+	out << setw(40) << left << "Phase" << right << setw(12) << "Time (ms)" << setw(8) << "Calls" << setw(12) << "RSS (MiB)" << endl;
+	for (Profiler::Phase const& phase: m_compiler->profiler().phases())
+	{
+		printRow(phase.name, phase.total);
+		for (auto const& contract: phase.contracts)
+			printRow("  " + contract.first, contract.second);
+	}
+	if (auto inlineAssemblyCache = m_compiler->inlineAssemblyCache())
+		out <<
+			"Inline assembly cache: " <<
+			inlineAssemblyCache->hits() <<
+			" hit(s), " <<
+			inlineAssemblyCache->misses() <<
+			" miss(es)." <<
+			endl;
+	if (auto yulFunctionRepository = m_compiler->yulFunctionRepository())
+		out <<
+			"Generated ABI functions: " <<
+			yulFunctionRepository->size() <<
+			" generated, " <<
+			yulFunctionRepository->hits() <<
+			" reused." <<
+			endl;
+	serr(false) << out.str();
+}
+
+void CommandLineInterface::handleYulOptimizerStatistics(yul::OptimiserStatistics const* _statistics)
+{
+	if (!m_args.count(g_argYulOptimizerStats) || !_statistics)
+		return;
+
+	map<char, string> const stepNames = yul::OptimiserSuite::stepAbbreviationToNameMap();
+	map<char, yul::OptimiserStatistics::StepTotals> const totals = _statistics->totals();
+	vector<char> steps;
+	for (auto const& step: totals)
+		steps.push_back(step.first);
+	// The most expensive steps first.
+	stable_sort(steps.begin(), steps.end(), [&](char _a, char _b) {
+		return totals.at(_a).time > totals.at(_b).time;
+	});
+
+	ostringstream out;
+	out << fixed;
+	out << endl << "======= Yul optimizer steps =======" << endl;
+	out <<
+		setw(34) << left << "Step" << right <<
+		setw(8) << "Runs" <<
+		setw(12) << "Time (ms)" <<
+		setw(14) << "Nodes before" <<
+		setw(13) << "Nodes after" <<
+		setw(13) << "Size before" <<
+		setw(12) << "Size after" <<
+		endl;
+	for (char step: steps)
+	{
+		yul::OptimiserStatistics::StepTotals const& stepTotals = totals.at(step);
+		out <<
+			setw(34) << left << (string(1, step) + " " + stepNames.at(step)) << right <<
+			setw(8) << stepTotals.runs <<
+			setw(12) << setprecision(3) << double(stepTotals.time.count()) / 1e6 <<
+			setw(14) << stepTotals.nodesBefore <<
+			setw(13) << stepTotals.nodesAfter <<
+			setw(13) << stepTotals.codeSizeBefore <<
+			setw(12) << stepTotals.codeSizeAfter <<
+			endl;
+	}
+
+	vector<size_t> rounds;
+	vector<yul::OptimiserStatistics::SuiteRun> const suiteRuns = _statistics->suiteRuns();
+	for (auto const& suiteRun: suiteRuns)
+		rounds += suiteRun.rounds;
+	out << "Yul optimizer runs: " << suiteRuns.size();
+	if (!rounds.empty())
+		out <<
+			", rounds until convergence: " <<
+			*min_element(rounds.begin(), rounds.end()) <<
+			" to " <<
+			*max_element(rounds.begin(), rounds.end()) <<
+			" (average " <<
+			setprecision(1) <<
+			double(accumulate(rounds.begin(), rounds.end(), size_t(0))) / rounds.size() <<
+			")";
+	out << "." << endl;
+
+	bool printedRemarksHeader = false;
+	for (auto const& suiteRun: suiteRuns)
+		for (auto const& remark: suiteRun.remarks)
+		{
+			if (!printedRemarksHeader)
+			{
+				out << endl << "======= Yul optimizer remarks =======" << endl;
+				printedRemarksHeader = true;
+			}
+			out << stepNames.at(remark.step);
+			if (remark.round)
+				out << " (round " << remark.round << ")";
+			out << ": " << remark.message << endl;
+		}
+	serr(false) << out.str();
+}
+
 void CommandLineInterface::outputCompilationResults()
 {
 	handleCombinedJSON();
@@ -1399,6 +1649,9 @@ void CommandLineInterface::outputCompilationResults()
 		else
 			serr() << "Compiler run successful, no output requested." << endl;
 	}
+
+	handleTimePasses();
+	handleYulOptimizerStatistics(m_compiler->yulOptimiserStatistics().get());
 }
 
 }
@@ -73,6 +73,8 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleFormal();
+	void handleTimePasses();
+	void handleYulOptimizerStatistics(yul::OptimiserStatistics const* _statistics);
 
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
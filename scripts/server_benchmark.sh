@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Compares the throughput of "polc --server" with one "polc --standard-json"
+# process per request.
+#
+# Usage: server_benchmark.sh <polc> <input.json> [<number of requests>]
+#
+# ------------------------------------------------------------------------------
+# This file is part of polynomial.
+#
+# polynomial is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# polynomial is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with polynomial.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2019 polynomial contributors.
+#------------------------------------------------------------------------------
+
+set -e
+
+if [ $# -lt 2 ]
+then
+    echo "Usage: $0 <polc> <input.json> [<number of requests>]"
+    exit 1
+fi
+
+POLC="$1"
+INPUT="$2"
+REQUESTS=${3:-100}
+
+TMPDIR=$(mktemp -d)
+trap "rm -rf $TMPDIR" EXIT
+
+# The server expects one request per line.
+REQUEST=$(tr -d '\n' < "$INPUT")
+for (( i = 0; i < REQUESTS; i++ ))
+do
+    echo "$REQUEST"
+done > "$TMPDIR/requests"
+
+start=$(date +%s%N)
+for (( i = 0; i < REQUESTS; i++ ))
+do
+    "$POLC" --standard-json < "$INPUT" >> "$TMPDIR/processes"
+done
+processes=$(( $(date +%s%N) - start ))
+
+start=$(date +%s%N)
+"$POLC" --server < "$TMPDIR/requests" > "$TMPDIR/server"
+server=$(( $(date +%s%N) - start ))
+
+if ! cmp -s "$TMPDIR/processes" "$TMPDIR/server"
+then
+    echo "The outputs of the server and of the separate processes differ."
+    exit 1
+fi
+
+echo "Requests:                $REQUESTS"
+echo "One process per request: $(( processes / 1000000 )) ms ($(( REQUESTS * 1000000000 / processes )) requests/s)"
+echo "Server:                  $(( server / 1000000 )) ms ($(( REQUESTS * 1000000000 / server )) requests/s)"
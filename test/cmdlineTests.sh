@@ -284,6 +284,28 @@ printTask "Running general commandline tests..."
     done
 )
 
+printTask "Testing server mode..."
+(
+    cd "$REPO_ROOT"/test/cmdlineTests/
+    # Every input is compiled separately and answered in a single line.
+    requests=""
+    expected=""
+    for tdir in standard_default_success/ standard_wrong_key_root/ standard_method_identifiers_requested/
+    do
+        requests+="$(tr -d '\n' < ${tdir}/input.json)"$'\n'
+        expected+="$("$POLC" --standard-json < ${tdir}/input.json)"$'\n'
+    done
+    output=$(echo "$requests" | "$POLC" --server)
+    if [ "$output"$'\n' != "$expected" ]
+    then
+        printError "Incorrect output of the server mode. Expected:"
+        echo "$expected"
+        printError "But got:"
+        echo "$output"
+        exit 1
+    fi
+)
+
 printTask "Compiling various other contracts and libraries..."
 (
     cd "$REPO_ROOT"/test/compilationTests/
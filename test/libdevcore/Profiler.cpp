@@ -0,0 +1,86 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the profiler of compilation phases.
+ */
+
+#include <libdevcore/Profiler.h>
+
+#include <test/Options.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(inactive)
+{
+	Profiler profiler;
+	{
+		ScopedPhase phase("a");
+	}
+	{
+		ProfilerScope scope(nullptr);
+		ScopedPhase phase("b");
+	}
+	BOOST_CHECK(profiler.phases().empty());
+	BOOST_CHECK(!Profiler::active());
+}
+
+BOOST_AUTO_TEST_CASE(phases_and_contracts)
+{
+	Profiler profiler;
+	{
+		ProfilerScope scope(&profiler);
+		BOOST_CHECK_EQUAL(Profiler::active(), &profiler);
+		ScopedPhase phase("parsing");
+		{
+			ProfilerScope contractScope(&profiler, "A");
+			ScopedPhase codegen("codegen");
+		}
+		for (char const* contract: {"B", "A"})
+		{
+			ProfilerScope contractScope(&profiler, contract);
+			ScopedPhase codegen("codegen");
+		}
+	}
+	BOOST_CHECK(!Profiler::active());
+
+	vector<Profiler::Phase> phases = profiler.phases();
+	BOOST_REQUIRE_EQUAL(phases.size(), 2);
+	BOOST_CHECK_EQUAL(phases[0].name, "codegen");
+	BOOST_CHECK_EQUAL(phases[0].total.calls, 3);
+	BOOST_REQUIRE_EQUAL(phases[0].contracts.size(), 2);
+	BOOST_CHECK_EQUAL(phases[0].contracts.at("A").calls, 2);
+	BOOST_CHECK_EQUAL(phases[0].contracts.at("B").calls, 1);
+	BOOST_CHECK_EQUAL(phases[1].name, "parsing");
+	BOOST_CHECK_EQUAL(phases[1].total.calls, 1);
+	BOOST_CHECK(phases[1].contracts.empty());
+	BOOST_CHECK(phases[1].total.time >= phases[0].total.time);
+
+	profiler.clear();
+	BOOST_CHECK(profiler.phases().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
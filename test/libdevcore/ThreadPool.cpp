@@ -0,0 +1,99 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include <test/Options.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(single_thread)
+{
+	ThreadPool pool(1);
+	BOOST_CHECK_EQUAL(pool.threads(), 1);
+	vector<size_t> order;
+	pool.run(5, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK((order == vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(every_task_runs_once)
+{
+	ThreadPool pool(4);
+	BOOST_CHECK_EQUAL(pool.threads(), 4);
+	// The pool is reused for several batches.
+	for (size_t count: {0, 1, 3, 1000})
+	{
+		vector<atomic<unsigned>> runs(count);
+		for (auto& run: runs)
+			run = 0;
+		pool.run(count, [&](size_t _index) { ++runs[_index]; });
+		for (auto const& run: runs)
+			BOOST_CHECK_EQUAL(run, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(exception_of_lowest_index)
+{
+	ThreadPool pool(3);
+	atomic<unsigned> finished{0};
+	try
+	{
+		pool.run(100, [&](size_t _index) {
+			if (_index == 17 || _index == 42)
+				throw runtime_error(to_string(_index));
+			++finished;
+		});
+		BOOST_FAIL("Expected an exception.");
+	}
+	catch (runtime_error const& _error)
+	{
+		BOOST_CHECK_EQUAL(_error.what(), string("17"));
+	}
+	BOOST_CHECK_EQUAL(finished, 98);
+}
+
+BOOST_AUTO_TEST_CASE(nested_batches)
+{
+	ThreadPool pool(3);
+	vector<atomic<unsigned>> runs(20 * 10);
+	for (auto& run: runs)
+		run = 0;
+	// Batches submitted by tasks are run sequentially by the task's thread.
+	pool.run(20, [&](size_t _outer) {
+		pool.run(10, [&](size_t _inner) { ++runs[_outer * 10 + _inner]; });
+	});
+	for (auto const& run: runs)
+		BOOST_CHECK_EQUAL(run, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -180,6 +180,47 @@ BOOST_AUTO_TEST_CASE(parameter_collision)
 	BOOST_CHECK_THROW(m.render(), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(incomplete_tags)
+{
+	// Everything that is not a complete tag is kept as it is.
+	string templ = "<> <a <#b> <?c> </d> <!e> <f<g> lt(<h>, 1)";
+	string result = Whiskers(templ)("f<g", "F")("h", "H").render();
+	BOOST_CHECK_EQUAL(result, "<> <a <#b> <?c> </d> <!e> F lt(H, 1)");
+}
+
+BOOST_AUTO_TEST_CASE(condition_inside_list)
+{
+	string templ = "<#b><?c><x><!c>-</c></b>";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "X";
+	list[1]["x"] = "Y";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("b", list).render(), "XY");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("b", list).render(), "--");
+}
+
+BOOST_AUTO_TEST_CASE(unused_branch_not_checked)
+{
+	string templ = "<?c><a><!c><b></c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "A").render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("b", "B").render(), "B");
+	BOOST_CHECK_THROW((Whiskers(templ)("c", true)("b", "B").render()), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(template_reused)
+{
+	// The parsed template is shared, the values are not.
+	string templ = "<a>(<#b><c></b>)";
+	vector<map<string, string>> list(1);
+	list[0]["c"] = "C";
+	Whiskers first(templ);
+	Whiskers second(templ);
+	first("a", "1")("b", list);
+	second("a", "2")("b", vector<map<string, string>>{});
+	BOOST_CHECK_EQUAL(first.render(), "1(C)");
+	BOOST_CHECK_EQUAL(second.render(), "2()");
+	BOOST_CHECK_EQUAL(first.render(), "1(C)");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,85 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the CharStream class.
+ */
+
+#include <liblangutil/CharStream.h>
+
+#include <test/Options.h>
+
+#include <tuple>
+
+using namespace std;
+
+namespace langutil
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(CharStreamTest)
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream const stream("ab\ncd\n\nefg", "source");
+	auto check = [&](int _position, int _line, int _column)
+	{
+		int line;
+		int column;
+		tie(line, column) = stream.translatePositionToLineColumn(_position);
+		BOOST_CHECK_EQUAL(line, _line);
+		BOOST_CHECK_EQUAL(column, _column);
+	};
+	check(0, 0, 0);
+	check(2, 0, 2);
+	check(3, 1, 0);
+	check(5, 1, 2);
+	check(6, 2, 0);
+	check(7, 3, 0);
+	check(9, 3, 2);
+	// Positions past the end are clamped.
+	check(10, 3, 3);
+	check(100, 3, 3);
+}
+
+BOOST_AUTO_TEST_CASE(line_at_position)
+{
+	CharStream const stream("ab\ncd\n\nefg", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(1), "ab");
+	// Positions of a newline belong to the line it ends.
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "cd");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(6), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(8), "efg");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "efg");
+	BOOST_CHECK_EQUAL(CharStream("", "").lineAtPosition(0), "");
+}
+
+BOOST_AUTO_TEST_CASE(assignment_resets_lines)
+{
+	CharStream stream("a\nb", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "b");
+	stream = CharStream("abc", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "abc");
+	BOOST_CHECK_EQUAL(std::get<0>(stream.translatePositionToLineColumn(2)), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+} // end namespaces
@@ -21,6 +21,7 @@
  */
 
 #include <liblangutil/SourceLocation.h>
+#include <liblangutil/SourceTable.h>
 
 #include <test/Options.h>
 
@@ -45,6 +46,31 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(source_references)
+{
+	BOOST_CHECK((sizeof(SourceLocation) <= 2 * sizeof(int) + sizeof(void*)));
+
+	SourceTable table;
+	SourceLocation location;
+	{
+		auto source = std::make_shared<CharStream>("abc", "source");
+		location = SourceLocation{0, 3, table.add(source)};
+		BOOST_CHECK(location.source);
+		BOOST_CHECK(location.source.get() == source.get());
+		BOOST_CHECK((location == SourceLocation{0, 3, source}));
+
+		// A copy of a stream is a different source.
+		auto copy = std::make_shared<CharStream>(*source);
+		BOOST_CHECK((SourceLocation{0, 3, copy} != location));
+	}
+	BOOST_CHECK(SourceLocation{}.source.get() == nullptr);
+
+	// The table keeps the source alive.
+	BOOST_CHECK_EQUAL(table.size(), size_t(1));
+	BOOST_CHECK_EQUAL(location.source->name(), "source");
+	BOOST_CHECK_EQUAL(location.source->source(), "abc");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -24,6 +24,7 @@
 #include <test/Options.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libpolynomial/ast/AST.h>
 #include <libpolynomial/interface/CompilerStack.h>
 
 #include <boost/test/unit_test.hpp>
@@ -542,6 +543,130 @@ BOOST_AUTO_TEST_CASE(inheritance_abi_encoder_match)
 	BOOST_CHECK_EQUAL(typeErrors, 0);
 }
 
+BOOST_AUTO_TEST_CASE(incremental_analysis)
+{
+	string const a = "pragma polynomial >=0.0; contract C { function f() public pure returns (uint) { return 1; } }";
+	string const b = "pragma polynomial >=0.0; import \"a\"; contract D is C { function g() public pure returns (uint) { return f(); } }";
+	string const e = "pragma polynomial >=0.0; contract E { function h() public pure { uint x; } }";
+	auto unusedVariableWarnings = [](CompilerStack const& _compiler)
+	{
+		return count_if(_compiler.errors().begin(), _compiler.errors().end(), [](shared_ptr<langutil::Error const> const& _error) {
+			return _error->type() == langutil::Error::Type::Warning && boost::get_error_info<errinfo_comment>(*_error) &&
+				*boost::get_error_info<errinfo_comment>(*_error) == "Unused local variable.";
+		});
+	};
+
+	string metadata;
+	{
+		CompilerStack c;
+		c.setSVMVersion(dev::test::Options::get().svmVersion());
+		c.enableIncrementalAnalysis();
+		c.setSources({{"a", a}, {"b", b}, {"e", e}});
+		BOOST_REQUIRE(c.compile());
+		BOOST_CHECK_EQUAL(unusedVariableWarnings(c), 1);
+		SourceUnit const* astA = &c.ast("a");
+		SourceUnit const* astE = &c.ast("e");
+
+		// Only "b" changes.
+		c.reset(true);
+		c.setSources({{"a", a}, {"b", b + " contract F is D {}"}, {"e", e}});
+		BOOST_REQUIRE(c.compile());
+		BOOST_CHECK(&c.ast("a") == astA);
+		BOOST_CHECK(&c.ast("e") == astE);
+		BOOST_CHECK_EQUAL(unusedVariableWarnings(c), 1);
+
+		// Errors in changed sources are reported and the retained analysis stays valid.
+		c.reset(true);
+		c.setSources({{"a", a}, {"b", b + " contract F is X {}"}, {"e", e}});
+		BOOST_CHECK(!c.compile());
+		c.reset(true);
+		c.setSources({{"a", a}, {"b", b}, {"e", e}});
+		BOOST_REQUIRE(c.compile());
+		BOOST_CHECK(&c.ast("a") == astA);
+		BOOST_CHECK(&c.ast("e") == astE);
+		SourceUnit const* astB = &c.ast("b");
+
+		// "b" does not change, but has to be analysed again since it imports "a".
+		c.reset(true);
+		c.setSources({{"a", a + " contract G {}"}, {"b", b}, {"e", e}});
+		BOOST_REQUIRE(c.compile());
+		BOOST_CHECK(&c.ast("b") != astB);
+		BOOST_CHECK(&c.ast("e") == astE);
+		BOOST_CHECK_EQUAL(unusedVariableWarnings(c), 1);
+		metadata = c.metadata("D");
+	}
+
+	CompilerStack c;
+	c.setSVMVersion(dev::test::Options::get().svmVersion());
+	c.setSources({{"a", a + " contract G {}"}, {"b", b}, {"e", e}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK_EQUAL(c.metadata("D"), metadata);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	// Sources that are only found through the read callback, some of them in later rounds.
+	map<string, string> const files{
+		{"lib/l0", "pragma polynomial >=0.0; import \"lib/l1\"; library L0 { function f() internal pure {} }"},
+		{"lib/l1", "pragma polynomial >=0.0; import \"lib/l2\"; library L1 { }"},
+		{"lib/l2", "pragma polynomial >=0.0; contract L2 { function f() public { assembly { let x := 1 } } }"},
+		{"lib/broken", "pragma polynomial >=0.0; import \"missing\"; contract B { function } "}
+	};
+	auto sources = [](bool _withErrors)
+	{
+		StringMap ret;
+		for (size_t i = 0; i < 12; ++i)
+			ret["s" + to_string(i)] =
+				"pragma polynomial >=0.0; import \"lib/l" + to_string(i % 3) + "\";" +
+				(_withErrors && i % 5 == 2 ? " import \"lib/broken\"; contract X { function } " : "") +
+				" contract C" + to_string(i) + " { function f() public pure returns (uint) { return " + to_string(i) + "; } }";
+		return ret;
+	};
+
+	// @returns the errors or the IDs of the source units and their last nodes.
+	auto parse = [&](unsigned _threads, bool _withErrors)
+	{
+		CompilerStack c([&](string const& _path) {
+			return files.count(_path) ?
+				ReadCallback::Result{true, files.at(_path)} :
+				ReadCallback::Result{false, "not found"};
+		});
+		c.setParallelism(_threads);
+		c.setSources(sources(_withErrors));
+		vector<string> result;
+		if (_withErrors)
+		{
+			BOOST_CHECK(!c.parse());
+			for (auto const& error: c.errors())
+			{
+				auto location = boost::get_error_info<langutil::errinfo_sourceLocation>(*error);
+				result.push_back(
+					*boost::get_error_info<errinfo_comment>(*error) +
+					(location && location->source ? " " + location->source->name() + ":" + to_string(location->start) : "")
+				);
+			}
+		}
+		else
+		{
+			BOOST_REQUIRE(c.parse());
+			for (string const& name: c.sourceNames())
+				result.push_back(name + " " + to_string(c.ast(name).id()) + " " + to_string(c.ast(name).nodes().back()->id()));
+		}
+		return result;
+	};
+
+	for (bool withErrors: {false, true})
+	{
+		vector<string> const sequential = parse(1, withErrors);
+		BOOST_CHECK(sequential.size() >= (withErrors ? 3 : 15));
+		for (unsigned threads: {2, 4, 16})
+		{
+			vector<string> const concurrent = parse(threads, withErrors);
+			BOOST_CHECK_EQUAL_COLLECTIONS(sequential.begin(), sequential.end(), concurrent.begin(), concurrent.end());
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
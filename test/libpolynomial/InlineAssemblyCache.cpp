@@ -0,0 +1,105 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * Unit tests for the cache of the inline assembly generated by the code generator.
+ */
+
+#include <test/Options.h>
+
+#include <libpolynomial/codegen/InlineAssemblyCache.h>
+#include <libpolynomial/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace polynomial
+{
+namespace test
+{
+
+namespace
+{
+
+string const c_sourceCode = R"(
+	pragma polynomial >=0.0;
+	pragma experimental ABIEncoderV2;
+	contract A {
+		function f(uint[] memory x, string memory y) public pure returns (uint[] memory, string memory) { return (x, y); }
+	}
+	contract B {
+		function g(uint[] memory x, string memory y) public pure returns (bytes memory) { return abi.encode(x, y); }
+	}
+)";
+
+map<string, bytes> compile(CompilerStack& _compiler)
+{
+	BOOST_REQUIRE(_compiler.compile());
+	map<string, bytes> bytecodes;
+	for (string const& name: _compiler.contractNames())
+		bytecodes[name] = _compiler.object(name).bytecode;
+	return bytecodes;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(InlineAssemblyCacheTest)
+
+BOOST_AUTO_TEST_CASE(identical_bytecode)
+{
+	for (auto settings: {OptimiserSettings::minimal(), OptimiserSettings::full()})
+	{
+		map<string, bytes> uncached;
+		{
+			CompilerStack compiler;
+			compiler.setSources({{"", c_sourceCode}});
+			compiler.setSVMVersion(dev::test::Options::get().svmVersion());
+			compiler.setOptimiserSettings(settings);
+			compiler.setInlineAssemblyCache(nullptr);
+			uncached = compile(compiler);
+			BOOST_CHECK(!compiler.inlineAssemblyCache());
+		}
+
+		CompilerStack compiler;
+		compiler.setSources({{"", c_sourceCode}});
+		compiler.setSVMVersion(dev::test::Options::get().svmVersion());
+		compiler.setOptimiserSettings(settings);
+		BOOST_CHECK(compile(compiler) == uncached);
+		auto cache = compiler.inlineAssemblyCache();
+		BOOST_REQUIRE(cache);
+		// Both contracts use the same ABI routines.
+		BOOST_CHECK(cache->hits() > 0);
+		size_t const misses = cache->misses();
+		BOOST_CHECK(misses > 0);
+
+		// The cache is kept if only the sources are replaced.
+		compiler.reset(true);
+		compiler.setSources({{"", c_sourceCode}});
+		BOOST_CHECK(compile(compiler) == uncached);
+		BOOST_CHECK_EQUAL(compiler.inlineAssemblyCache()->misses(), misses);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
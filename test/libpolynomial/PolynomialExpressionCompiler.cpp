@@ -97,14 +97,14 @@ bytes compileFirstExpression(
 	vector<vector<string>> _localVariables = {}
 )
 {
+	// Source locations do not keep their source alive.
+	auto scanner = make_shared<Scanner>(CharStream(_sourceCode, ""));
 	ASTPointer<SourceUnit> sourceUnit;
 	try
 	{
 		ErrorList errors;
 		ErrorReporter errorReporter(errors);
-		sourceUnit = Parser(errorReporter, dev::test::Options::get().svmVersion()).parse(
-			make_shared<Scanner>(CharStream(_sourceCode, ""))
-		);
+		sourceUnit = Parser(errorReporter, dev::test::Options::get().svmVersion()).parse(scanner);
 		if (!sourceUnit)
 			return bytes();
 	}
@@ -23,11 +23,14 @@
 #include <string>
 #include <memory>
 #include <liblangutil/Scanner.h>
+#include <liblangutil/SourceTable.h>
 #include <libpolynomial/parsing/Parser.h>
 #include <liblangutil/ErrorReporter.h>
 #include <test/Options.h>
 #include <test/libpolynomial/ErrorCheck.h>
 #include <libpolynomial/ast/ASTVisitor.h>
+#include <libpolynomial/ast/ASTJsonConverter.h>
+#include <libdevcore/JSON.h>
 
 using namespace std;
 using namespace langutil;
@@ -43,11 +46,15 @@ namespace
 {
 ASTPointer<ContractDefinition> parseText(std::string const& _source, ErrorList& _errors)
 {
+	// Source locations do not keep their source alive, so the sources of all tests are kept.
+	static SourceTable sources;
+	auto scanner = std::make_shared<Scanner>(CharStream(_source, ""));
+	sources.add(scanner->charStream());
 	ErrorReporter errorReporter(_errors);
 	ASTPointer<SourceUnit> sourceUnit = Parser(
 		errorReporter,
 		dev::test::Options::get().svmVersion()
-	).parse(std::make_shared<Scanner>(CharStream(_source, "")));
+	).parse(scanner);
 	if (!sourceUnit)
 		return ASTPointer<ContractDefinition>();
 	for (ASTPointer<ASTNode> const& node: sourceUnit->nodes())
@@ -671,6 +678,54 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
 }
 
+BOOST_AUTO_TEST_CASE(arena_allocation)
+{
+	// The JSON converter requires the annotations of imports and function calls,
+	// so the source does not contain any.
+	string const sourceCode = R"(
+		pragma polynomial >=0.0;
+		/// @title C
+		contract C {
+			struct S { uint a; bytes b; }
+			enum E { X, Y }
+			mapping(uint => S) m;
+			function f(uint x) public returns (uint r) {
+				for (uint i = 0; i < x; i++)
+					r += m[i].a * 2;
+				assembly { r := add(r, 1) }
+			}
+			event Ev(string indexed s);
+		}
+	)";
+	// The scanners own the sources the locations of the nodes refer to.
+	vector<shared_ptr<Scanner>> scanners;
+	auto parse = [&](bool _useArena)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		Parser parser(errorReporter, dev::test::Options::get().svmVersion());
+		parser.useArena(_useArena);
+		ASTNode::resetID();
+		scanners.push_back(make_shared<Scanner>(CharStream(sourceCode, "")));
+		ASTPointer<SourceUnit> sourceUnit = parser.parse(scanners.back());
+		BOOST_REQUIRE(sourceUnit);
+		BOOST_CHECK(errors.empty());
+		return sourceUnit;
+	};
+	ASTPointer<SourceUnit> withArena = parse(true);
+	ASTPointer<SourceUnit> withoutArena = parse(false);
+	BOOST_CHECK_EQUAL(
+		jsonCompactPrint(ASTJsonConverter(false, {{"", 0}}).toJson(*withArena)),
+		jsonCompactPrint(ASTJsonConverter(false, {{"", 0}}).toJson(*withoutArena))
+	);
+
+	// Nodes keep their arena alive.
+	ASTPointer<ASTNode> contract = withArena->nodes().back();
+	withArena.reset();
+	BOOST_CHECK_EQUAL(dynamic_cast<ContractDefinition const&>(*contract).name(), "C");
+	BOOST_CHECK_EQUAL(dynamic_cast<ContractDefinition const&>(*contract).definedStructs().size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
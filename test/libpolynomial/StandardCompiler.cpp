@@ -26,6 +26,8 @@
 #include <libdevcore/JSON.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+
 using namespace std;
 using namespace dev::sof;
 
@@ -582,6 +584,51 @@ BOOST_AUTO_TEST_CASE(output_selection_dependent_contract)
 	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(contract["abi"]), "[{\"constant\":false,\"inputs\":[],\"name\":\"f\",\"outputs\":[],\"payable\":false,\"stateMutability\":\"nonpayable\",\"type\":\"function\"}]");
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_per_contract_stages)
+{
+	string const sources = R"(
+		"sources": {
+			"fileA": {
+				"content": "contract B { } contract A { function f() public { new B(); } } contract C { }"
+			}
+		}
+	)";
+	Json::Value result = compile(R"({
+		"language": "Polynomial",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": [ "abi" ],
+					"A": [ "svm.bytecode.object" ],
+					"C": [ "ir" ]
+				}
+			}
+		},)" + sources + "}"
+	);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value a = getContractResult(result, "fileA", "A");
+	Json::Value b = getContractResult(result, "fileA", "B");
+	Json::Value c = getContractResult(result, "fileA", "C");
+	BOOST_CHECK(a["abi"].isArray() && b["abi"].isArray() && c["abi"].isArray());
+	BOOST_REQUIRE(a["svm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(!b.isMember("svm") && !b.isMember("ir"));
+	BOOST_CHECK(!c.isMember("svm"));
+	BOOST_CHECK(c["ir"].isString() && !c["ir"].asString().empty());
+
+	// The dependency B is compiled although its bytecode was not requested.
+	Json::Value full = compile(R"({
+		"language": "Polynomial",
+		"settings": {
+			"outputSelection": { "*": { "*": [ "svm.bytecode.object" ] } }
+		},)" + sources + "}"
+	);
+	BOOST_CHECK(containsAtMostWarnings(full));
+	BOOST_CHECK_EQUAL(
+		a["svm"]["bytecode"]["object"].asString(),
+		getContractResult(full, "fileA", "A")["svm"]["bytecode"]["object"].asString()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(output_selection_dependent_contract_with_import)
 {
 	char const* input = R"(
@@ -1035,6 +1082,43 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_optimizer_steps)
+{
+	char const* input = R"(
+	{
+		"language": "Polynomial",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "svm.bytecode.object" ] }
+			},
+			"optimizer": { "details": {
+				"yul": true,
+				"yulDetails": { "optimizerSteps": "dhfoDgvu [xarrscQu] jmu" }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental ABIEncoderV2; contract A { function f(uint[] memory x) public pure returns (uint[] memory) { return x; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.optimizerSteps\": 'Q' is not a valid optimizer step abbreviation."));
+
+	string validInput = input;
+	validInput.replace(validInput.find("scQu"), 4, "scu");
+	result = compile(validInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(!contract["svm"]["bytecode"]["object"].asString().empty());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK_EQUAL(yulDetails["optimizerSteps"].asString(), "dhfoDgvu [xarrscu] jmu");
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1097,6 +1181,190 @@ BOOST_AUTO_TEST_CASE(common_pattern)
 	BOOST_CHECK(contract["svm"]["bytecode"]["object"].isString());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	string const sources = R"(
+		"sources": {
+			"fileA": {
+				"content": "contract B { function f() public pure returns (uint) { return 7; } } contract A { function g() public { new B(); } } contract C { B b = new B(); } contract D { function h(uint x) public pure returns (uint) { return x * 3; } }"
+			}
+		}
+	)";
+	string const outputSelection = R"(
+		"outputSelection": {
+			"*": { "*": [ "svm.bytecode", "svm.deployedBytecode", "metadata" ] }
+		}
+	)";
+	Json::Value sequential = compile(
+		"{\"language\": \"Polynomial\", \"settings\": {\"optimizer\": { \"enabled\": true }, " +
+		outputSelection + "}, " + sources + "}"
+	);
+	Json::Value parallel = compile(
+		"{\"language\": \"Polynomial\", \"settings\": {\"optimizer\": { \"enabled\": true }, \"parallelism\": 4, " +
+		outputSelection + "}, " + sources + "}"
+	);
+	BOOST_CHECK(containsAtMostWarnings(sequential));
+	BOOST_CHECK(containsAtMostWarnings(parallel));
+	for (char const* name: {"A", "B", "C", "D"})
+	{
+		Json::Value contract = getContractResult(parallel, "fileA", name);
+		BOOST_REQUIRE(contract["svm"]["bytecode"]["object"].isString());
+		BOOST_CHECK(contract == getContractResult(sequential, "fileA", name));
+	}
+
+	Json::Value result = compile(
+		"{\"language\": \"Polynomial\", \"settings\": {\"parallelism\": 0}, " + sources + "}"
+	);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive number."));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	boost::filesystem::path const cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("polc-cache-%%%%-%%%%");
+	string const fileA = R"(
+		"fileA": {
+			"content": "contract B { function f() public pure returns (uint) { return 7; } } contract A { function g() public { new B(); } } interface I { function f() external; }"
+		}
+	)";
+	// Sorts before fileA and thus changes the source indices.
+	string const fileAA = R"(
+		"aa": {
+			"content": "contract Z { }"
+		}
+	)";
+	string const settings = R"(
+		"optimizer": { "enabled": true },
+		"outputSelection": {
+			"*": { "*": [ "svm.bytecode", "svm.deployedBytecode", "svm.assembly", "svm.legacyAssembly", "svm.gasEstimates" ] }
+		}
+	)";
+	string const cacheSetting = "\"cacheDirectory\": \"" + cacheDirectory.string() + "\", ";
+	auto input = [&](string const& _cacheSetting, string const& _sources)
+	{
+		return "{\"language\": \"Polynomial\", \"settings\": {" + _cacheSetting + settings + "}, \"sources\": {" + _sources + "}}";
+	};
+
+	Json::Value first = compile(input(cacheSetting, fileA));
+	BOOST_CHECK(containsAtMostWarnings(first));
+	BOOST_CHECK_EQUAL(first["cache"]["hits"].asUInt(), 0);
+	BOOST_CHECK_EQUAL(first["cache"]["misses"].asUInt(), 2);
+
+	Json::Value second = compile(input(cacheSetting, fileAA + "," + fileA));
+	BOOST_CHECK(containsAtMostWarnings(second));
+	BOOST_CHECK_EQUAL(second["cache"]["hits"].asUInt(), 2);
+	BOOST_CHECK_EQUAL(second["cache"]["misses"].asUInt(), 1);
+
+	Json::Value uncached = compile(input("", fileAA + "," + fileA));
+	BOOST_CHECK(containsAtMostWarnings(uncached));
+	BOOST_CHECK(!uncached.isMember("cache"));
+	for (char const* name: {"A", "B", "I"})
+		BOOST_CHECK(getContractResult(second, "fileA", name) == getContractResult(uncached, "fileA", name));
+
+	boost::filesystem::remove_all(cacheDirectory);
+
+	Json::Value result = compile(
+		"{\"language\": \"Polynomial\", \"settings\": {\"cacheDirectory\": 1}, \"sources\": {" + fileA + "}}"
+	);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.cacheDirectory\" must be a string."));
+}
+
+BOOST_AUTO_TEST_CASE(profiling)
+{
+	string const sources = R"(
+		"sources": {
+			"fileA": {
+				"content": "contract B { } contract A { function f() public { new B(); } }"
+			}
+		}
+	)";
+	Json::Value result = compile(R"({
+		"language": "Polynomial",
+		"settings": {
+			"profiling": true,
+			"outputSelection": { "*": { "*": [ "svm.bytecode" ] } }
+		},)" + sources + "}"
+	);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& profiling = result["profiling"];
+	BOOST_REQUIRE(profiling.isObject());
+	for (char const* phase: {"parsing", "typeChecker", "metadata", "codeGeneration", "assemblyOptimiser", "assembling", "sourceMapping"})
+	{
+		BOOST_REQUIRE_MESSAGE(profiling.isMember(phase), phase);
+		BOOST_CHECK(profiling[phase]["time"].isDouble());
+		BOOST_CHECK(profiling[phase]["calls"].asUInt() >= 1);
+		BOOST_CHECK(profiling[phase]["peakRSS"].isUInt64());
+	}
+	BOOST_CHECK_EQUAL(profiling["parsing"]["calls"].asUInt(), 1);
+	BOOST_CHECK(!profiling["parsing"].isMember("contracts"));
+	Json::Value const& codeGeneration = profiling["codeGeneration"]["contracts"];
+	BOOST_CHECK_EQUAL(codeGeneration.size(), 2);
+	BOOST_CHECK_EQUAL(codeGeneration["fileA:A"]["calls"].asUInt(), 1);
+	BOOST_CHECK_EQUAL(codeGeneration["fileA:B"]["calls"].asUInt(), 1);
+
+	result = compile(R"({"language": "Polynomial", "settings": {"outputSelection": { "*": { "*": [ "svm.bytecode" ] } }},)" + sources + "}");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("profiling"));
+
+	result = compile(R"({"language": "Polynomial", "settings": {"profiling": 1},)" + sources + "}");
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profiling\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(yul_optimizer_statistics)
+{
+	string const sources = R"(
+		"sources": {
+			"A": { "content": "{ let x := calldataload(0) let y := add(x, 0) sstore(y, mul(x, 1)) }" }
+		}
+	)";
+	Json::Value result = compile(R"({
+		"language": "Yul",
+		"settings": {
+			"yulOptimizerStatistics": true,
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection": { "*": { "*": [ "svm.bytecode" ] } }
+		},)" + sources + "}"
+	);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& statistics = result["yulOptimizerStatistics"];
+	BOOST_REQUIRE(statistics.isObject());
+	BOOST_CHECK_EQUAL(statistics["optimizerRuns"].asUInt(), 1);
+	BOOST_REQUIRE_EQUAL(statistics["rounds"].size(), 1);
+	BOOST_CHECK(statistics["rounds"][0].asUInt() >= 1);
+	Json::Value const& simplifier = statistics["steps"]["ExpressionSimplifier"];
+	BOOST_REQUIRE(simplifier.isObject());
+	BOOST_CHECK_EQUAL(simplifier["abbreviation"].asString(), "s");
+	BOOST_CHECK(simplifier["runs"].asUInt() >= 1);
+	BOOST_CHECK(simplifier["time"].isDouble());
+	BOOST_CHECK(simplifier["nodesAfter"].asUInt() <= simplifier["nodesBefore"].asUInt());
+	BOOST_CHECK(statistics["remarks"].isArray());
+
+	result = compile(R"({
+		"language": "Yul",
+		"settings": {
+			"yulOptimizerStatistics": true,
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection": { "*": { "*": [ "svm.bytecode" ] } }
+		},
+		"sources": {
+			"A": { "content": "{ function f(a) { sstore(a, 1) sstore(add(a, 1), 2) } f(calldataload(0)) }" }
+		}
+	})");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& remarks = result["yulOptimizerStatistics"]["remarks"];
+	BOOST_REQUIRE(remarks.isArray());
+	BOOST_REQUIRE(!remarks.empty());
+	BOOST_CHECK_EQUAL(remarks[0]["step"].asString(), "FullInliner");
+	BOOST_CHECK_EQUAL(remarks[0]["message"].asString(), "Inlined f into the main code: the function is only called once.");
+
+	result = compile(R"({"language": "Yul", "settings": {"optimizer": { "enabled": true, "details": { "yul": true } }},)" + sources + "}");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("yulOptimizerStatistics"));
+
+	result = compile(R"({"language": "Yul", "settings": {"yulOptimizerStatistics": "yes"},)" + sources + "}");
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.yulOptimizerStatistics\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_CASE(use_stack_optimization)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -0,0 +1,113 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the sharing of generated Yul functions across contracts.
+ */
+
+#include <test/Options.h>
+
+#include <libpolynomial/codegen/MultiUseYulFunctionCollector.h>
+#include <libpolynomial/codegen/YulFunctionRepository.h>
+#include <libpolynomial/interface/CompilerStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace polynomial
+{
+namespace test
+{
+
+namespace
+{
+
+/// Requests "f", which calls "g", from @a _collector and counts the invocations of the creators.
+string requestF(MultiUseYulFunctionCollector& _collector, unsigned& o_created)
+{
+	return _collector.createFunction("f", [&]() {
+		++o_created;
+		string const g = _collector.createFunction("g", [&]() {
+			++o_created;
+			return string("function g() {}");
+		});
+		return "function f() { " + g + "() }";
+	});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulFunctionRepositoryTest)
+
+BOOST_AUTO_TEST_CASE(shared_functions)
+{
+	auto repository = make_shared<YulFunctionRepository>();
+	unsigned created = 0;
+
+	MultiUseYulFunctionCollector first(repository);
+	BOOST_CHECK_EQUAL(requestF(first, created), "f");
+	BOOST_CHECK_EQUAL(created, 2);
+	string const code = first.requestedFunctions();
+	BOOST_CHECK_EQUAL(code, "function f() { g() }function g() {}");
+	BOOST_CHECK_EQUAL(repository->size(), 2);
+
+	// The second collector takes "f" and the function it calls from the repository.
+	MultiUseYulFunctionCollector second(repository);
+	BOOST_CHECK_EQUAL(requestF(second, created), "f");
+	BOOST_CHECK_EQUAL(created, 2);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), code);
+	BOOST_CHECK_EQUAL(repository->hits(), 1);
+
+	// Without a repository, the functions are generated again.
+	MultiUseYulFunctionCollector unshared;
+	requestF(unshared, created);
+	BOOST_CHECK_EQUAL(created, 4);
+	BOOST_CHECK_EQUAL(unshared.requestedFunctions(), code);
+}
+
+BOOST_AUTO_TEST_CASE(shared_across_contracts)
+{
+	char const* sourceCode = R"(
+		pragma polynomial >=0.0;
+		pragma experimental ABIEncoderV2;
+		contract A {
+			function f(uint[] memory x, string memory y) public pure returns (bytes memory) { return abi.encode(x, y); }
+		}
+		contract B {
+			function g(uint[] memory x, string memory y) public pure returns (bytes memory) { return abi.encode(x, y); }
+		}
+	)";
+	CompilerStack compiler;
+	compiler.setSources({{"", sourceCode}});
+	compiler.setSVMVersion(dev::test::Options::get().svmVersion());
+	BOOST_CHECK(!compiler.yulFunctionRepository());
+	BOOST_REQUIRE(compiler.compile());
+	auto repository = compiler.yulFunctionRepository();
+	BOOST_REQUIRE(repository);
+	BOOST_CHECK(repository->size() > 0);
+	BOOST_CHECK(repository->hits() > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
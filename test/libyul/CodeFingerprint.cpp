@@ -0,0 +1,103 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the code fingerprints.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/CodeFingerprint.h>
+#include <libyul/AsmData.h>
+
+using namespace std;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+shared_ptr<Block> parseCode(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return ast;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulCodeFingerprint)
+
+BOOST_AUTO_TEST_CASE(copy_has_same_fingerprint)
+{
+	shared_ptr<Block> ast = parseCode("{ let x := add(1, calldataload(0)) function f(a) -> b { b := a } sstore(f(x), 2) }");
+	Block copy = boost::get<Block>(ASTCopier{}(*ast));
+	BOOST_CHECK(CodeFingerprint::run(*ast) == CodeFingerprint::run(copy));
+}
+
+BOOST_AUTO_TEST_CASE(names_are_taken_into_account)
+{
+	shared_ptr<Block> ast = parseCode("{ let x := 1 let y := 2 sstore(x, y) }");
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(*ast);
+	boost::get<VariableDeclaration>(ast->statements[0]).variables[0].name = YulString{"z"};
+	BOOST_CHECK(CodeFingerprint::run(*ast) != fingerprint);
+}
+
+BOOST_AUTO_TEST_CASE(literals_are_taken_into_account)
+{
+	shared_ptr<Block> ast = parseCode("{ sstore(0, 1) }");
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(*ast);
+	auto& call = boost::get<FunctionCall>(boost::get<ExpressionStatement>(ast->statements[0]).expression);
+	boost::get<Literal>(call.arguments[1]).value = YulString{"2"};
+	BOOST_CHECK(CodeFingerprint::run(*ast) != fingerprint);
+}
+
+BOOST_AUTO_TEST_CASE(order_is_taken_into_account)
+{
+	shared_ptr<Block> ast = parseCode("{ { sstore(0, 1) } { sstore(1, 0) } }");
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(*ast);
+	swap(ast->statements[0], ast->statements[1]);
+	BOOST_CHECK(CodeFingerprint::run(*ast) != fingerprint);
+}
+
+BOOST_AUTO_TEST_CASE(structure_is_taken_into_account)
+{
+	shared_ptr<Block> ast = parseCode("{ { sstore(0, 1) } }");
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(*ast);
+	Block inner = std::move(boost::get<Block>(ast->statements[0]));
+	ast->statements = std::move(inner.statements);
+	BOOST_CHECK(CodeFingerprint::run(*ast) != fingerprint);
+}
+
+BOOST_AUTO_TEST_CASE(source_locations_are_taken_into_account)
+{
+	shared_ptr<Block> ast = parseCode("{ sstore(0, 1) }");
+	CodeFingerprint::Fingerprint fingerprint = CodeFingerprint::run(*ast);
+	boost::get<ExpressionStatement>(ast->statements[0]).location.end++;
+	BOOST_CHECK(CodeFingerprint::run(*ast) != fingerprint);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,111 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for matching the simplification rules against Yul expressions.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/svm/SVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/AsmPrinter.h>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+/// Matches the value of the last variable declaration of @a _source against the simplification
+/// rules and @returns the replacement or an empty string if no rule matches.
+string simplifyLastValue(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	SSAValueTracker ssaValues;
+	ssaValues(*ast);
+	auto const ssaValue = [&](YulString _name) -> Expression const* {
+		auto value = ssaValues.values().find(_name);
+		return value == ssaValues.values().end() ? nullptr : value->second;
+	};
+	Expression const& value = *boost::get<VariableDeclaration>(ast->statements.back()).value;
+	auto rule = SimplificationRules::findFirstMatch(
+		value,
+		SVMDialect::strictAssemblyForSVM(dev::test::Options::get().svmVersion()),
+		ssaValue
+	);
+	if (!rule)
+		return {};
+	return boost::apply_visitor(AsmPrinter{}, rule->action().toExpression(SourceLocation{}));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSimplificationRules)
+
+BOOST_AUTO_TEST_CASE(constant_folding)
+{
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := add(2, 3) }"), "5");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := sub(0, 1) }"), "0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+}
+
+BOOST_AUTO_TEST_CASE(specific_constants)
+{
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := and(calldataload(0), 0) }"), "0");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := eq(calldataload(0), 0) }"), "iszero(calldataload(0))");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := eq(calldataload(0), 1) }"), "");
+}
+
+BOOST_AUTO_TEST_CASE(nested_patterns)
+{
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := not(not(calldataload(0))) }"), "calldataload(0)");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := iszero(iszero(iszero(calldataload(0)))) }"), "iszero(calldataload(0))");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := not(iszero(calldataload(0))) }"), "");
+}
+
+BOOST_AUTO_TEST_CASE(ssa_values)
+{
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := 2 let x := mul(a, 3) }"), "6");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := not(calldataload(0)) let x := not(a) }"), "calldataload(0)");
+	// Variables are only resolved below the root of the expression.
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := add(2, 3) let x := a }"), "");
+	// Variables that are assigned to are not resolved.
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := 2 a := calldataload(0) let x := mul(a, 3) }"), "");
+}
+
+BOOST_AUTO_TEST_CASE(match_groups)
+{
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := calldataload(0) let x := sub(a, a) }"), "0");
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let a := calldataload(0) let b := calldataload(0) let x := sub(a, b) }"), "");
+	// The repeated expression has to be movable.
+	BOOST_CHECK_EQUAL(simplifyLastValue("{ let x := sub(mload(0), mload(0)) }"), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
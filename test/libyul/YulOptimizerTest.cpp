@@ -32,10 +32,13 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -60,6 +63,7 @@
 #include <liblangutil/Scanner.h>
 
 #include <libdevcore/AnsiColorized.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string.hpp>
@@ -98,6 +102,12 @@ YulOptimizerTest::YulOptimizerTest(string const& _filename)
 		m_validatedSettings["step"] = m_settings["step"];
 		m_settings.erase("step");
 	}
+	if (m_settings.count("runs"))
+	{
+		m_runs = stoul(m_settings["runs"]);
+		m_validatedSettings["runs"] = m_settings["runs"];
+		m_settings.erase("runs");
+	}
 
 	string line;
 	while (getline(file, line))
@@ -122,9 +132,19 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 	}
 	else if (m_optimizerStep == "constantOptimiser")
 	{
-		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, 200);
+		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, m_runs);
 		ConstantOptimiser{dynamic_cast<SVMDialect const&>(*m_dialect), meter}(*m_ast);
 	}
+	else if (m_optimizerStep == "functionSpecializer")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		FunctionHoister{}(*m_ast);
+		FunctionGrouper{}(*m_ast);
+		NameDispenser nameDispenser{*m_dialect, *m_ast};
+		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, m_runs);
+		FunctionSpecializer::run(*m_dialect, meter, *m_ast, nameDispenser);
+	}
 	else if (m_optimizerStep == "varDeclInitializer")
 		VarDeclInitializer{}(*m_ast);
 	else if (m_optimizerStep == "varNameCleaner")
@@ -184,7 +204,8 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		(FunctionGrouper{})(*m_ast);
 		NameDispenser nameDispenser{*m_dialect, *m_ast};
 		ExpressionSplitter{*m_dialect, nameDispenser}(*m_ast);
-		FullInliner(*m_ast, nameDispenser).run();
+		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, m_runs);
+		FullInliner(*m_ast, nameDispenser, meter).run();
 		ExpressionJoiner::run(*m_ast);
 	}
 	else if (m_optimizerStep == "mainFunction")
@@ -213,15 +234,35 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		ForLoopInitRewriter{}(*m_ast);
 		CommonSubexpressionEliminator{*m_dialect}(*m_ast);
 		ExpressionSimplifier::run(*m_dialect, *m_ast);
-		UnusedPruner::runUntilStabilised(*m_dialect, *m_ast);
+		UnusedPruner::run(*m_dialect, *m_ast);
 		DeadCodeEliminator{*m_dialect}(*m_ast);
 		ExpressionJoiner::run(*m_ast);
 		ExpressionJoiner::run(*m_ast);
 	}
+	else if (m_optimizerStep == "loadResolver")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		NameDispenser nameDispenser{*m_dialect, *m_ast};
+		ExpressionSplitter{*m_dialect, nameDispenser}(*m_ast);
+		CommonSubexpressionEliminator{*m_dialect}(*m_ast);
+		ExpressionSimplifier::run(*m_dialect, *m_ast);
+		LoadResolver::run(*m_dialect, *m_ast);
+		UnusedPruner::run(*m_dialect, *m_ast);
+		ExpressionJoiner::run(*m_ast);
+		ExpressionJoiner::run(*m_ast);
+	}
+	else if (m_optimizerStep == "loopInvariantCodeMotion")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		FunctionHoister{}(*m_ast);
+		LoopInvariantCodeMotion::run(*m_dialect, *m_ast);
+	}
 	else if (m_optimizerStep == "unusedPruner")
 	{
 		disambiguate();
-		UnusedPruner::runUntilStabilised(*m_dialect, *m_ast);
+		UnusedPruner::run(*m_dialect, *m_ast);
 	}
 	else if (m_optimizerStep == "deadCodeEliminator")
 	{
@@ -277,7 +318,7 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 		// reverse SSA
 		SSAReverser::run(*m_ast);
 		CommonSubexpressionEliminator{*m_dialect}(*m_ast);
-		UnusedPruner::runUntilStabilised(*m_dialect, *m_ast);
+		UnusedPruner::run(*m_dialect, *m_ast);
 	}
 	else if (m_optimizerStep == "stackCompressor")
 	{
@@ -296,8 +337,20 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 	}
 	else if (m_optimizerStep == "fullSuite")
 	{
-		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, 200);
+		GasMeter meter(dynamic_cast<SVMDialect const&>(*m_dialect), false, m_runs);
 		OptimiserSuite::run(*m_dialect, meter, *m_ast, *m_analysisInfo, true);
+
+		// The result must not depend on the number of threads.
+		shared_ptr<Block> sequentialResult = m_ast;
+		if (!parse(_stream, _linePrefix, _formatted))
+			return TestResult::FatalError;
+		ThreadPool threadPool(4);
+		OptimiserSuite::run(*m_dialect, meter, *m_ast, *m_analysisInfo, true, {}, OptimiserSuite::DefaultSequence, &threadPool);
+		if (AsmPrinter{m_yul}(*m_ast) != AsmPrinter{m_yul}(*sequentialResult))
+		{
+			AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Result differs when optimizing with several threads." << endl;
+			return TestResult::FatalError;
+		}
 	}
 	else
 	{
@@ -64,6 +64,8 @@ private:
 	std::string m_source;
 	bool m_yul = false;
 	std::string m_optimizerStep;
+	/// Expected number of executions per deployment that the gas meter assumes.
+	size_t m_runs = 200;
 	std::string m_expectation;
 
 	Dialect const* m_dialect = nullptr;
@@ -0,0 +1,187 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for parsing Polynomial sources and destroying the resulting ASTs,
+ * with and without arena allocation of the AST nodes.
+ */
+
+#include <libpolynomial/parsing/Parser.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+using namespace dev::polynomial;
+
+namespace po = boost::program_options;
+
+namespace
+{
+size_t g_allocations = 0;
+}
+
+void* operator new(size_t _size)
+{
+	++g_allocations;
+	if (void* memory = malloc(_size ? _size : 1))
+		return memory;
+	throw bad_alloc();
+}
+
+void operator delete(void* _memory) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	free(_memory);
+}
+
+namespace
+{
+
+struct Measurement
+{
+	chrono::nanoseconds parseTime{0};
+	size_t parseAllocations = 0;
+	chrono::nanoseconds teardownTime{0};
+};
+
+Measurement run(vector<pair<string, string>> const& _sources, unsigned _repetitions, bool _useArena)
+{
+	Measurement result;
+	for (unsigned i = 0; i < _repetitions; ++i)
+		for (auto const& source: _sources)
+		{
+			auto scanner = make_shared<Scanner>(CharStream(source.second, source.first));
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			ASTPointer<SourceUnit> ast;
+			{
+				Parser parser(errorReporter, SVMVersion());
+				parser.useArena(_useArena);
+
+				size_t const allocationsBefore = g_allocations;
+				auto const start = chrono::steady_clock::now();
+				ast = parser.parse(scanner);
+				result.parseTime += chrono::steady_clock::now() - start;
+				result.parseAllocations += g_allocations - allocationsBefore;
+			}
+			if (!ast)
+			{
+				cerr << "Failed to parse " << source.first << endl;
+				exit(1);
+			}
+
+			auto const start = chrono::steady_clock::now();
+			ast.reset();
+			result.teardownTime += chrono::steady_clock::now() - start;
+		}
+	return result;
+}
+
+void print(string const& _name, Measurement const& _measurement, unsigned _repetitions)
+{
+	cout <<
+		setw(20) << left << _name << right <<
+		setw(14) << fixed << setprecision(3) << double(_measurement.parseTime.count()) / 1e6 / _repetitions <<
+		setw(16) << _measurement.parseAllocations / _repetitions <<
+		setw(16) << fixed << setprecision(3) << double(_measurement.teardownTime.count()) / 1e6 / _repetitions <<
+		endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(astbench, benchmark for the allocation of the Polynomial AST.
+Usage: astbench [Options] <file>...
+Parses the given files and destroys the resulting ASTs, once with every
+node allocated individually and once with the nodes of each source unit
+allocated in an arena, and reports the time and the number of heap
+allocations needed per repetition.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-file",
+			po::value<vector<string>>(),
+			"input files"
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(10),
+			"Number of repetitions."
+		)
+		("help", "Show this help screen.");
+
+	// All positional options should be interpreted as input files
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<pair<string, string>> sources;
+	for (string const& file: arguments["input-file"].as<vector<string>>())
+		sources.emplace_back(file, readFileAsString(file));
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+
+	// Warm up caches and the global allocator.
+	run(sources, 1, true);
+	run(sources, 1, false);
+
+	cout << setw(20) << left << "" << right << setw(14) << "Parse (ms)" << setw(16) << "Allocations" << setw(16) << "Teardown (ms)" << endl;
+	print("Individual nodes", run(sources, repetitions, false), repetitions);
+	print("Arena", run(sources, repetitions, true), repetitions);
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for the common subexpression eliminator on functions with many variables.
+ */
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/backends/svm/SVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Utilities.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Generates a function that declares @a _variables variables in a single block, about a
+/// quarter of which are assigned an expression that was already assigned to another variable.
+string generate(unsigned _variables, unsigned _seed)
+{
+	static vector<string> const operations{"add", "sub", "mul", "xor", "and", "or"};
+	mt19937 random(_seed);
+	auto uniform = [&](size_t _bound) { return uniform_int_distribution<size_t>(0, _bound - 1)(random); };
+
+	vector<string> values{"add(a, 1)"};
+	string code = "{\nfunction f(a) -> r {\nlet v0 := add(a, 1)\n";
+	for (unsigned i = 1; i < _variables; ++i)
+	{
+		string value;
+		if (uniform(4) == 0)
+			value = values[uniform(values.size())];
+		else
+			value =
+				operations[uniform(operations.size())] +
+				"(v" + to_string(uniform(i)) + ", mul(a, " + to_string(i) + "))";
+		values.push_back(value);
+		code += "let v" + to_string(i) + " := " + value + "\n";
+	}
+	code += "r := v" + to_string(_variables - 1) + "\n}\nsstore(0, f(calldataload(0)))\n}\n";
+	return code;
+}
+
+/// Common subexpression eliminator that compares every expression to all known values,
+/// used as reference.
+class LinearCommonSubexpressionEliminator: public DataFlowAnalyzer
+{
+public:
+	explicit LinearCommonSubexpressionEliminator(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+
+protected:
+	using ASTModifier::visit;
+	void visit(Expression& _e) override
+	{
+		bool descend = true;
+		if (_e.type() == typeid(FunctionCall))
+			if (BuiltinFunction const* builtin = m_dialect.builtin(boost::get<FunctionCall>(_e).functionName.name))
+				if (builtin->literalArguments)
+					descend = false;
+		if (descend)
+			DataFlowAnalyzer::visit(_e);
+
+		if (_e.type() == typeid(Identifier))
+		{
+			YulString name = boost::get<Identifier>(_e).name;
+			if (m_value.count(name) && m_value.at(name)->type() == typeid(Identifier))
+				_e = Identifier{locationOf(_e), boost::get<Identifier>(*m_value.at(name)).name};
+		}
+		else
+			for (auto const& var: m_value)
+				if (SyntacticallyEqual{}(_e, *var.second))
+				{
+					_e = Identifier{locationOf(_e), var.first};
+					break;
+				}
+	}
+};
+
+template <class Eliminator>
+chrono::nanoseconds measure(Dialect const& _dialect, Block const& _code, unsigned _repetitions, string& _result)
+{
+	chrono::nanoseconds time{0};
+	for (unsigned i = 0; i < _repetitions; ++i)
+	{
+		Block copy = boost::get<Block>(ASTCopier{}(_code));
+		auto const start = chrono::steady_clock::now();
+		Eliminator{_dialect}(copy);
+		time += chrono::steady_clock::now() - start;
+		if (i == 0)
+			_result = AsmPrinter{}(copy);
+	}
+	return time;
+}
+
+double milliseconds(chrono::nanoseconds _time, unsigned _repetitions)
+{
+	return double(_time.count()) / 1e6 / _repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(csebench, benchmark for the common subexpression eliminator of the Yul optimiser.
+Usage: csebench [Options]
+Generates functions with an increasing number of variables and reports the time
+needed per repetition by the common subexpression eliminator and by a reference
+implementation that compares every expression to the values of all variables.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"min-variables",
+			po::value<unsigned>()->default_value(1000),
+			"Number of variables of the smallest function."
+		)
+		(
+			"max-variables",
+			po::value<unsigned>()->default_value(16000),
+			"Maximum number of variables, the number is doubled for every function."
+		)
+		(
+			"seed",
+			po::value<unsigned>()->default_value(1),
+			"Seed for the code generator."
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(3),
+			"Number of repetitions."
+		)
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	SVMDialect const& dialect = SVMDialect::strictAssemblyForSVM(SVMVersion());
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+
+	cout << setw(12) << "Variables" << setw(20) << "Hash table (ms)" << setw(16) << "Linear (ms)" << endl;
+	for (
+		unsigned variables = max(1u, arguments["min-variables"].as<unsigned>());
+		variables <= arguments["max-variables"].as<unsigned>();
+		variables *= 2
+	)
+	{
+		AssemblyStack stack(SVMVersion(), AssemblyStack::Language::StrictAssembly, OptimiserSettings::minimal());
+		if (!stack.parseAndAnalyze("generated", generate(variables, arguments["seed"].as<unsigned>())))
+		{
+			SourceReferenceFormatter formatter(cerr);
+			for (auto const& error: stack.errors())
+				formatter.printExceptionInformation(*error, (error->type() == Error::Type::Warning) ? "Warning" : "Error");
+			return 1;
+		}
+		Block const& code = *stack.parserResult()->code;
+
+		string result;
+		string expectedResult;
+		chrono::nanoseconds const hashTime = measure<CommonSubexpressionEliminator>(dialect, code, repetitions, result);
+		chrono::nanoseconds const linearTime = measure<LinearCommonSubexpressionEliminator>(dialect, code, repetitions, expectedResult);
+		if (result != expectedResult)
+		{
+			cerr << "Result differs from the reference implementation for " << variables << " variables." << endl;
+			return 1;
+		}
+
+		cout << fixed << setprecision(3) <<
+			setw(12) << variables <<
+			setw(20) << milliseconds(hashTime, repetitions) <<
+			setw(16) << milliseconds(linearTime, repetitions) <<
+			endl;
+	}
+
+	return 0;
+}
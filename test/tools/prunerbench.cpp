@@ -0,0 +1,284 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for the unused pruner on Yul sources.
+ */
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/UnusedPruner.h>
+#include <libyul/backends/svm/SVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/algorithm/cxx11/none_of.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Reference implementation that recounts all references and walks the whole AST
+/// until no more references are removed.
+class IterativeUnusedPruner: public ASTModifier
+{
+public:
+	IterativeUnusedPruner(Dialect const& _dialect, Block& _ast, bool _allowMSizeOptimization):
+		m_dialect(_dialect),
+		m_allowMSizeOptimization(_allowMSizeOptimization),
+		m_references(ReferencesCounter::countReferences(_ast))
+	{}
+
+	static void runUntilStabilised(Dialect const& _dialect, Block& _ast)
+	{
+		bool const allowMSizeOptimization = !SideEffectsCollector(_dialect, _ast).containsMSize();
+		while (true)
+		{
+			IterativeUnusedPruner pruner(_dialect, _ast, allowMSizeOptimization);
+			pruner(_ast);
+			if (!pruner.m_shouldRunAgain)
+				return;
+		}
+	}
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override
+	{
+		for (auto&& statement: _block.statements)
+			if (statement.type() == typeid(FunctionDefinition))
+			{
+				FunctionDefinition& funDef = boost::get<FunctionDefinition>(statement);
+				if (!used(funDef.name))
+				{
+					subtractReferences(ReferencesCounter::countReferences(funDef.body));
+					statement = Block{std::move(funDef.location), {}};
+				}
+			}
+			else if (statement.type() == typeid(VariableDeclaration))
+			{
+				VariableDeclaration& varDecl = boost::get<VariableDeclaration>(statement);
+				if (boost::algorithm::none_of(
+					varDecl.variables,
+					[=](TypedName const& _typedName) { return used(_typedName.name); }
+				))
+				{
+					if (!varDecl.value)
+						statement = Block{std::move(varDecl.location), {}};
+					else if (SideEffectsCollector(m_dialect, *varDecl.value).sideEffectFree(m_allowMSizeOptimization))
+					{
+						subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
+						statement = Block{std::move(varDecl.location), {}};
+					}
+					else if (varDecl.variables.size() == 1)
+						statement = ExpressionStatement{varDecl.location, FunctionalInstruction{
+							varDecl.location,
+							dev::sof::Instruction::POP,
+							{*std::move(varDecl.value)}
+						}};
+				}
+			}
+			else if (statement.type() == typeid(ExpressionStatement))
+			{
+				ExpressionStatement& exprStmt = boost::get<ExpressionStatement>(statement);
+				if (SideEffectsCollector(m_dialect, exprStmt.expression).sideEffectFree(m_allowMSizeOptimization))
+				{
+					subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
+					statement = Block{std::move(exprStmt.location), {}};
+				}
+			}
+
+		removeEmptyBlocks(_block);
+
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	bool used(YulString _name) const
+	{
+		return m_references.count(_name) && m_references.at(_name) > 0;
+	}
+
+	void subtractReferences(map<YulString, size_t> const& _subtrahend)
+	{
+		for (auto const& ref: _subtrahend)
+		{
+			m_references[ref.first] -= ref.second;
+			m_shouldRunAgain = true;
+		}
+	}
+
+	Dialect const& m_dialect;
+	bool m_allowMSizeOptimization = false;
+	bool m_shouldRunAgain = false;
+	map<YulString, size_t> m_references;
+};
+
+template <class Prune>
+chrono::nanoseconds measure(Block const& _code, unsigned _repetitions, string& _result, Prune const& _prune)
+{
+	chrono::nanoseconds time{0};
+	for (unsigned i = 0; i < _repetitions; ++i)
+	{
+		Block copy = boost::get<Block>(ASTCopier{}(_code));
+		auto const start = chrono::steady_clock::now();
+		_prune(copy);
+		time += chrono::steady_clock::now() - start;
+		if (i == 0)
+			_result = AsmPrinter{}(copy);
+	}
+	return time;
+}
+
+double milliseconds(chrono::nanoseconds _time, unsigned _repetitions)
+{
+	return double(_time.count()) / 1e6 / _repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(prunerbench, benchmark for the unused pruner of the Yul optimiser.
+Usage: prunerbench [Options] <file>...
+Reports the time needed per repetition by the unused pruner and by a reference
+implementation that walks the whole code again until it does not change anymore,
+for each of the given Yul sources, and checks that both produce the same code.
+Sources that cannot be parsed as strict assembly are skipped.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-file",
+			po::value<vector<string>>(),
+			"Input files."
+		)
+		(
+			"prepare",
+			"Split the expressions, transform the code into SSA form and eliminate common "
+			"subexpressions before pruning, which leaves many variables unused."
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(10),
+			"Number of repetitions."
+		)
+		("help", "Show this help screen.");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	SVMDialect const& dialect = SVMDialect::strictAssemblyForSVMObjects(SVMVersion());
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+	chrono::nanoseconds totalTime{0};
+	chrono::nanoseconds totalReferenceTime{0};
+
+	cout << setw(50) << left << "Source" << right << setw(16) << "Pruner (ms)" << setw(18) << "Reference (ms)" << endl;
+	for (string const& file: arguments["input-file"].as<vector<string>>())
+	{
+		AssemblyStack stack(SVMVersion(), AssemblyStack::Language::StrictAssembly, OptimiserSettings::minimal());
+		if (!stack.parseAndAnalyze(file, readFileAsString(file)))
+		{
+			cerr << "Skipping " << file << ": not strict assembly." << endl;
+			continue;
+		}
+		Block code = boost::get<Block>(Disambiguator(dialect, *stack.parserResult()->analysisInfo)(*stack.parserResult()->code));
+		if (arguments.count("prepare"))
+		{
+			ForLoopInitRewriter{}(code);
+			NameDispenser nameDispenser{dialect, code};
+			ExpressionSplitter{dialect, nameDispenser}(code);
+			SSATransform::run(code, nameDispenser);
+			CommonSubexpressionEliminator{dialect}(code);
+			ExpressionSimplifier::run(dialect, code);
+		}
+
+		string result;
+		string expectedResult;
+		chrono::nanoseconds const time = measure(code, repetitions, result, [&](Block& _code) {
+			UnusedPruner::run(dialect, _code);
+		});
+		chrono::nanoseconds const referenceTime = measure(code, repetitions, expectedResult, [&](Block& _code) {
+			IterativeUnusedPruner::runUntilStabilised(dialect, _code);
+		});
+		if (result != expectedResult)
+		{
+			cerr << "Result differs from the reference implementation for " << file << ":" << endl;
+			cerr << result << endl << "Expected:" << endl << expectedResult << endl;
+			return 1;
+		}
+		totalTime += time;
+		totalReferenceTime += referenceTime;
+
+		cout << fixed << setprecision(3) <<
+			setw(50) << left << file << right <<
+			setw(16) << milliseconds(time, repetitions) <<
+			setw(18) << milliseconds(referenceTime, repetitions) <<
+			endl;
+	}
+	cout << fixed << setprecision(3) <<
+		setw(50) << left << "Total" << right <<
+		setw(16) << milliseconds(totalTime, repetitions) <<
+		setw(18) << milliseconds(totalReferenceTime, repetitions) <<
+		endl;
+
+	return 0;
+}
@@ -0,0 +1,309 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for matching the simplification rules against large generated Yul code.
+ */
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/svm/SVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsvmasm/RuleList.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+using namespace dev::sof;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Generates straight-line code that assigns random arithmetic expressions over
+/// calldata, constants and previously declared variables to fresh variables.
+class CodeGenerator
+{
+public:
+	CodeGenerator(unsigned _seed, unsigned _depth): m_random(_seed), m_depth(_depth) {}
+
+	string generate(unsigned _statements)
+	{
+		string code = "{\n";
+		for (unsigned i = 0; i < _statements; ++i)
+			code += "let v" + to_string(i) + " := " + expression(m_depth, i) + "\n";
+		if (_statements > 0)
+			code += "sstore(0, v" + to_string(_statements - 1) + ")\n";
+		return code + "}\n";
+	}
+
+private:
+	string expression(unsigned _depth, unsigned _variables)
+	{
+		static vector<string> const unary{"iszero", "not"};
+		static vector<string> const binary{
+			"add", "sub", "mul", "div", "sdiv", "mod", "exp", "and", "or", "xor",
+			"shl", "shr", "lt", "gt", "slt", "sgt", "eq", "byte", "signextend"
+		};
+		static vector<string> const constants{"0", "1", "2", "0x20", "0xff", "not(0)"};
+
+		unsigned const choice = uniform(10);
+		if (_depth == 0 || choice < 2)
+		{
+			if (choice == 0 || _variables == 0)
+				return constants[uniform(constants.size())];
+			else if (choice == 1)
+				return "calldataload(" + to_string(32 * uniform(8)) + ")";
+			else
+				return "v" + to_string(_variables - 1 - uniform(min(_variables, 16u)));
+		}
+		else if (choice < 3)
+			return unary[uniform(unary.size())] + "(" + expression(_depth - 1, _variables) + ")";
+		else
+			return
+				binary[uniform(binary.size())] + "(" +
+				expression(_depth - 1, _variables) + ", " +
+				expression(_depth - 1, _variables) + ")";
+	}
+
+	unsigned uniform(size_t _bound) { return uniform_int_distribution<unsigned>(0, _bound - 1)(m_random); }
+
+	mt19937 m_random;
+	unsigned m_depth;
+};
+
+/// Collects all expressions of a block.
+class ExpressionCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void visit(Expression const& _expression) override
+	{
+		expressions.push_back(&_expression);
+		ASTWalker::visit(_expression);
+	}
+
+	vector<Expression const*> expressions;
+};
+
+/// Reference implementation that tries every rule for the instruction of the expression.
+class LinearRules
+{
+public:
+	LinearRules()
+	{
+		yul::Pattern A(PatternKind::Constant);
+		yul::Pattern B(PatternKind::Constant);
+		yul::Pattern C(PatternKind::Constant);
+		yul::Pattern X;
+		yul::Pattern Y;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		X.setMatchGroup(4, m_matchGroups);
+		Y.setMatchGroup(5, m_matchGroups);
+		for (auto const& rule: simplificationRuleList(A, B, C, X, Y))
+			m_rules[uint8_t(rule.pattern.instruction())].push_back(rule);
+	}
+
+	SimplificationRule<yul::Pattern> const* findFirstMatch(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		function<Expression const*(YulString)> const& _ssaValues
+	)
+	{
+		auto instruction = SimplificationRules::instructionAndArguments(_dialect, _expr);
+		if (!instruction)
+			return nullptr;
+		for (auto const& rule: m_rules[uint8_t(instruction->first)])
+		{
+			m_matchGroups.clear();
+			if (rule.pattern.matches(_expr, _dialect, _ssaValues))
+				if (!rule.feasible || rule.feasible())
+					return &rule;
+		}
+		return nullptr;
+	}
+
+private:
+	map<unsigned, Expression const*> m_matchGroups;
+	vector<SimplificationRule<yul::Pattern>> m_rules[256];
+};
+
+string replacement(SimplificationRule<yul::Pattern> const* _rule)
+{
+	if (!_rule)
+		return {};
+	return boost::apply_visitor(AsmPrinter{}, _rule->action().toExpression(SourceLocation{}));
+}
+
+double milliseconds(chrono::nanoseconds _time, unsigned _repetitions)
+{
+	return double(_time.count()) / 1e6 / _repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(simplifierbench, benchmark for the simplification rules of the Yul optimiser.
+Usage: simplifierbench [Options]
+Generates straight-line Yul code consisting of random arithmetic expressions and
+reports the time needed per repetition to find the matching simplification rule
+for every expression, both with the decision tree used by the optimiser and by
+trying every rule for the instruction of the expression, as well as the time
+needed by the expression simplifier for the whole code.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"statements",
+			po::value<unsigned>()->default_value(20000),
+			"Number of generated statements."
+		)
+		(
+			"depth",
+			po::value<unsigned>()->default_value(4),
+			"Maximum nesting depth of the generated expressions."
+		)
+		(
+			"seed",
+			po::value<unsigned>()->default_value(1),
+			"Seed for the code generator."
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(10),
+			"Number of repetitions."
+		)
+		("print", "Print the generated code and exit.")
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	string const source =
+		CodeGenerator(arguments["seed"].as<unsigned>(), arguments["depth"].as<unsigned>()).
+		generate(arguments["statements"].as<unsigned>());
+	if (arguments.count("print"))
+	{
+		cout << source;
+		return 0;
+	}
+
+	SVMDialect const& dialect = SVMDialect::strictAssemblyForSVM(SVMVersion());
+	AssemblyStack stack(SVMVersion(), AssemblyStack::Language::StrictAssembly, OptimiserSettings::minimal());
+	if (!stack.parseAndAnalyze("generated", source))
+	{
+		SourceReferenceFormatter formatter(cerr);
+		for (auto const& error: stack.errors())
+			formatter.printExceptionInformation(*error, (error->type() == Error::Type::Warning) ? "Warning" : "Error");
+		return 1;
+	}
+	Block const& code = *stack.parserResult()->code;
+
+	ExpressionCollector collector;
+	collector(code);
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(code);
+	function<Expression const*(YulString)> const ssaValues = [&](YulString _name) -> Expression const* {
+		auto value = ssaValueTracker.values().find(_name);
+		return value == ssaValueTracker.values().end() ? nullptr : value->second;
+	};
+
+	LinearRules linearRules;
+	size_t matches = 0;
+	for (Expression const* expression: collector.expressions)
+	{
+		string const expected = replacement(linearRules.findFirstMatch(*expression, dialect, ssaValues));
+		string const actual = replacement(SimplificationRules::findFirstMatch(*expression, dialect, ssaValues));
+		if (expected != actual)
+		{
+			cerr <<
+				"Mismatch for " << boost::apply_visitor(AsmPrinter{}, *expression) << ": expected \"" <<
+				expected << "\", got \"" << actual << "\"" << endl;
+			return 1;
+		}
+		if (!actual.empty())
+			++matches;
+	}
+
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+	chrono::nanoseconds treeTime{0};
+	chrono::nanoseconds linearTime{0};
+	chrono::nanoseconds simplifierTime{0};
+	for (unsigned i = 0; i < repetitions; ++i)
+	{
+		auto start = chrono::steady_clock::now();
+		for (Expression const* expression: collector.expressions)
+			SimplificationRules::findFirstMatch(*expression, dialect, ssaValues);
+		treeTime += chrono::steady_clock::now() - start;
+
+		start = chrono::steady_clock::now();
+		for (Expression const* expression: collector.expressions)
+			linearRules.findFirstMatch(*expression, dialect, ssaValues);
+		linearTime += chrono::steady_clock::now() - start;
+
+		Block copy = boost::get<Block>(ASTCopier{}(code));
+		start = chrono::steady_clock::now();
+		ExpressionSimplifier::run(dialect, copy);
+		simplifierTime += chrono::steady_clock::now() - start;
+	}
+
+	cout << "Expressions: " << collector.expressions.size() << ", matching a rule: " << matches << endl;
+	cout << fixed << setprecision(3);
+	cout << setw(30) << left << "Rule matching, tree (ms)" << right << setw(12) << milliseconds(treeTime, repetitions) << endl;
+	cout << setw(30) << left << "Rule matching, linear (ms)" << right << setw(12) << milliseconds(linearTime, repetitions) << endl;
+	cout << setw(30) << left << "Expression simplifier (ms)" << right << setw(12) << milliseconds(simplifierTime, repetitions) << endl;
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for the Whiskers templates, comparing the parsed and cached templates to the
+ * regular expression based replacement they were rendered with before.
+ */
+
+#include <libdevcore/Whiskers.h>
+
+#include <boost/program_options.hpp>
+#include <boost/regex.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+using StringMap = Whiskers::StringMap;
+using StringListMap = Whiskers::StringListMap;
+
+/// The regular expression based implementation of Whiskers::render, for reference.
+string regexReplace(
+	string const& _template,
+	StringMap const& _parameters,
+	map<string, bool> const& _conditions,
+	StringListMap const& _listParameters = StringListMap()
+)
+{
+	static boost::regex listOrTag("<([^#/?!>]+)>|<#([^>]+)>(.*?)</\\2>|<\\?([^>]+)>(.*?)(<!\\4>(.*?))?</\\4>");
+	return boost::regex_replace(_template, listOrTag, [&](boost::match_results<string::const_iterator> _match) -> string
+	{
+		string tagName(_match[1]);
+		string listName(_match[2]);
+		string conditionName(_match[4]);
+		if (!tagName.empty())
+			return _parameters.at(tagName);
+		else if (!listName.empty())
+		{
+			string replacement;
+			for (auto const& parameters: _listParameters.at(listName))
+			{
+				StringMap joined = _parameters;
+				joined.insert(parameters.begin(), parameters.end());
+				replacement += regexReplace(_match[3], joined, _conditions);
+			}
+			return replacement;
+		}
+		else
+			return regexReplace(
+				_conditions.at(conditionName) ? _match[5] : _match[7],
+				_parameters,
+				_conditions,
+				_listParameters
+			);
+	});
+}
+
+/// Template in the style of the ABI coder functions.
+string const c_template = R"(
+	// <readableTypeNameFrom> -> <readableTypeNameTo>
+	function <functionName>(value,<maybeLength> pos) <return> {
+		<declareLength>
+		pos := <storeLength>(pos, length)
+		let baseRef := <dataAreaFun>(value)
+		let srcPtr := baseRef
+		for { let i := 0 } lt(i, length) { i := add(i, 1) }
+		{
+			let <elementValues> := <arrayElementAccess>
+			pos := <encodeToMemoryFun>(<elementValues>, pos)
+			srcPtr := <nextArrayElement>(srcPtr)
+		}
+		<?dynamic>
+			end := pos
+		<!dynamic>
+			pos := add(pos, <length>)
+		</dynamic>
+		<#members>
+			mstore(add(pos, <offset>), <encode>(<memberValue>))
+		</members>
+	}
+)";
+
+StringMap const c_parameters{
+	{"readableTypeNameFrom", "uint256[] memory"},
+	{"readableTypeNameTo", "uint256[] memory"},
+	{"functionName", "abi_encode_t_array$_t_uint256_$dyn_memory_ptr_to_t_array$_t_uint256_$dyn_memory_ptr"},
+	{"maybeLength", ""},
+	{"return", "-> end"},
+	{"declareLength", "let length := array_length_t_array$_t_uint256_$dyn_memory_ptr(value)"},
+	{"storeLength", "array_storeLengthForEncoding_t_array$_t_uint256_$dyn_memory_ptr"},
+	{"dataAreaFun", "array_dataslot_t_array$_t_uint256_$dyn_memory_ptr"},
+	{"elementValues", "elementValue0"},
+	{"arrayElementAccess", "mload(srcPtr)"},
+	{"encodeToMemoryFun", "abi_encode_t_uint256_to_t_uint256"},
+	{"nextArrayElement", "array_nextElement_t_array$_t_uint256_$dyn_memory_ptr"},
+	{"length", "0x20"}
+};
+
+vector<StringMap> const c_members{
+	{{"offset", "0x00"}, {"encode", "cleanup_t_uint256"}, {"memberValue", "mload(value)"}},
+	{{"offset", "0x20"}, {"encode", "cleanup_t_address"}, {"memberValue", "mload(add(value, 0x20))"}},
+	{{"offset", "0x40"}, {"encode", "cleanup_t_bool"}, {"memberValue", "mload(add(value, 0x40))"}}
+};
+
+string renderWhiskers()
+{
+	Whiskers templ(c_template);
+	for (auto const& parameter: c_parameters)
+		templ(parameter.first, parameter.second);
+	templ("dynamic", true);
+	templ("members", c_members);
+	return templ.render();
+}
+
+string renderRegex()
+{
+	return regexReplace(c_template, c_parameters, {{"dynamic", true}}, {{"members", c_members}});
+}
+
+double measure(string (*_render)(), unsigned _repetitions)
+{
+	auto const start = chrono::steady_clock::now();
+	size_t length = 0;
+	for (unsigned i = 0; i < _repetitions; ++i)
+		length += _render().size();
+	auto const time = chrono::steady_clock::now() - start;
+	// Use the result, so that rendering cannot be optimised away.
+	if (length == 0)
+		cerr << "Empty result." << endl;
+	return double(chrono::duration_cast<chrono::nanoseconds>(time).count()) / 1e3 / _repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(whiskersbench, benchmark for the rendering of Whiskers templates.
+Usage: whiskersbench [Options]
+Renders a template in the style of the ABI coder functions, once through
+Whiskers and once through the regular expression based replacement, and
+reports the time needed per rendering.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(100000),
+			"Number of repetitions."
+		)
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	if (renderWhiskers() != renderRegex())
+	{
+		cerr << "Results differ:" << endl << renderWhiskers() << endl << renderRegex() << endl;
+		return 1;
+	}
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+
+	cout << setw(20) << left << "" << right << setw(16) << "Render (us)" << endl;
+	cout << setw(20) << left << "Whiskers" << right << setw(16) << fixed << setprecision(3) << measure(renderWhiskers, repetitions) << endl;
+	cout << setw(20) << left << "Regular expression" << right << setw(16) << fixed << setprecision(3) << measure(renderRegex, repetitions) << endl;
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+	This file is part of polynomial.
+
+	polynomial is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	polynomial is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MSRCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with polynomial.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark for parsing, optimising and assembling Yul code.
+ */
+
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/SourceLocation.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Profiler.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::polynomial;
+using namespace langutil;
+using namespace yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+struct Measurement
+{
+	chrono::nanoseconds parseTime{0};
+	chrono::nanoseconds optimiseTime{0};
+	chrono::nanoseconds assembleTime{0};
+};
+
+double milliseconds(chrono::nanoseconds _time, unsigned _repetitions)
+{
+	return double(_time.count()) / 1e6 / _repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulbench, benchmark for the Yul optimiser.
+Usage: yulbench [Options] <file>...
+Parses, optimises and assembles the given strict assembly files and reports
+the time needed per repetition for every step, together with the peak memory
+usage of the process.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"input-file",
+			po::value<vector<string>>(),
+			"input files"
+		)
+		(
+			"repeat",
+			po::value<unsigned>()->default_value(10),
+			"Number of repetitions."
+		)
+		("help", "Show this help screen.");
+
+	// All positional options should be interpreted as input files
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	unsigned const repetitions = max(1u, arguments["repeat"].as<unsigned>());
+	vector<pair<string, Measurement>> measurements;
+	for (string const& file: arguments["input-file"].as<vector<string>>())
+	{
+		string const source = readFileAsString(file);
+		Measurement measurement;
+		for (unsigned i = 0; i < repetitions; ++i)
+		{
+			AssemblyStack stack(SVMVersion(), AssemblyStack::Language::StrictAssembly, OptimiserSettings::full());
+
+			auto start = chrono::steady_clock::now();
+			bool const success = stack.parseAndAnalyze(file, source);
+			measurement.parseTime += chrono::steady_clock::now() - start;
+			if (!success)
+			{
+				SourceReferenceFormatter formatter(cerr);
+				for (auto const& error: stack.errors())
+					formatter.printExceptionInformation(*error, (error->type() == Error::Type::Warning) ? "Warning" : "Error");
+				return 1;
+			}
+
+			start = chrono::steady_clock::now();
+			stack.optimize();
+			measurement.optimiseTime += chrono::steady_clock::now() - start;
+
+			start = chrono::steady_clock::now();
+			stack.assemble(AssemblyStack::Machine::SVM);
+			measurement.assembleTime += chrono::steady_clock::now() - start;
+		}
+		measurements.emplace_back(file, measurement);
+	}
+
+	cout << setw(30) << left << "" << right << setw(14) << "Parse (ms)" << setw(14) << "Optimise (ms)" << setw(16) << "Assemble (ms)" << endl;
+	for (auto const& measurement: measurements)
+		cout <<
+			setw(30) << left << measurement.first << right << fixed << setprecision(3) <<
+			setw(14) << milliseconds(measurement.second.parseTime, repetitions) <<
+			setw(14) << milliseconds(measurement.second.optimiseTime, repetitions) <<
+			setw(16) << milliseconds(measurement.second.assembleTime, repetitions) <<
+			endl;
+	cout << "Peak memory usage: " << Profiler::peakRSS() / 1024 << " KiB" << endl;
+	cout << "Size of a source location: " << sizeof(SourceLocation) << " bytes" << endl;
+
+	return 0;
+}
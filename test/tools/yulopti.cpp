@@ -43,6 +43,8 @@
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/MainFunction.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserStatistics.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/UnusedPruner.h>
@@ -53,6 +55,7 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/Suite.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 
@@ -62,6 +65,7 @@
 
 #include <boost/program_options.hpp>
 
+#include <iomanip>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -174,8 +178,11 @@ public:
 				ExpressionInliner{m_dialect, *m_ast}.run();
 				break;
 			case 'i':
-				FullInliner(*m_ast, *m_nameDispenser).run();
+			{
+				GasMeter meter(dynamic_cast<SVMDialect const&>(m_dialect), false, 200);
+				FullInliner(*m_ast, *m_nameDispenser, meter).run();
 				break;
+			}
 			case 's':
 				ExpressionSimplifier::run(m_dialect, *m_ast);
 				break;
@@ -186,7 +193,7 @@ public:
 				(ControlFlowSimplifier{m_dialect})(*m_ast);
 				break;
 			case 'u':
-				UnusedPruner::runUntilStabilised(m_dialect, *m_ast);
+				UnusedPruner::run(m_dialect, *m_ast);
 				break;
 			case 'D':
 				DeadCodeEliminator{m_dialect}(*m_ast);
@@ -216,6 +223,42 @@ public:
 		}
 	}
 
+	/// Runs the optimiser suite with the step sequence @a _sequence on @a _source and
+	/// prints the statistics of every application of a step.
+	void runSuite(string const& _source, string const& _sequence)
+	{
+		if (!parse(_source))
+			return;
+		OptimiserStatistics statistics;
+		GasMeter meter(dynamic_cast<SVMDialect const&>(m_dialect), false, 200);
+		OptimiserSuite::run(m_dialect, meter, *m_ast, *m_analysisInfo, true, {}, _sequence, nullptr, &statistics);
+
+		map<char, string> const stepNames = OptimiserSuite::stepAbbreviationToNameMap();
+		cout <<
+			setw(6) << "Round" << "  " <<
+			setw(32) << left << "Step" << right <<
+			setw(12) << "Time (us)" <<
+			setw(14) << "Nodes before" <<
+			setw(13) << "Nodes after" <<
+			setw(13) << "Size before" <<
+			setw(12) << "Size after" <<
+			endl;
+		OptimiserStatistics::SuiteRun const run = statistics.suiteRuns().front();
+		for (OptimiserStatistics::StepRun const& step: run.steps)
+			cout <<
+				setw(6) << (step.round ? to_string(step.round) : "-") << "  " <<
+				setw(32) << left << (string(1, step.step) + " " + stepNames.at(step.step)) << right <<
+				setw(12) << chrono::duration_cast<chrono::microseconds>(step.time).count() <<
+				setw(14) << step.nodesBefore <<
+				setw(13) << step.nodesAfter <<
+				setw(13) << step.codeSizeBefore <<
+				setw(12) << step.codeSizeAfter <<
+				endl;
+		for (size_t rounds: run.rounds)
+			cout << "Repeated part of the sequence converged after " << rounds << " round(s)." << endl;
+		cout << "Code size: " << CodeSize::codeSizeIncludingFunctions(*m_ast) << endl;
+	}
+
 private:
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
@@ -231,6 +274,8 @@ int main(int argc, char** argv)
 Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
 interactively read from stdin.
+With --statistics, runs the optimizer suite instead and prints
+the time and the effect of every step it applied.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -241,6 +286,15 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"statistics",
+			"Run the optimizer suite non-interactively and print statistics for every step."
+		)
+		(
+			"steps",
+			po::value<string>()->default_value(OptimiserSuite::DefaultSequence),
+			"Sequence of steps run by the optimizer suite together with --statistics."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -261,7 +315,21 @@ Allowed options)",
 	}
 
 	string input;
-	if (arguments.count("input-file"))
+	if (arguments.count("input-file") && arguments.count("statistics"))
+	{
+		string const sequence = arguments["steps"].as<string>();
+		try
+		{
+			OptimiserSuite::validateSequence(sequence);
+		}
+		catch (OptimizerException const& _exception)
+		{
+			cerr << "Invalid step sequence: " << *boost::get_error_info<errinfo_comment>(_exception) << endl;
+			return 1;
+		}
+		YulOpti{}.runSuite(readFileAsString(arguments["input-file"].as<string>()), sequence);
+	}
+	else if (arguments.count("input-file"))
 		YulOpti{}.runInteractive(readFileAsString(arguments["input-file"].as<string>()));
 	else
 		cout << options;